@@ -0,0 +1,140 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the entity queries of the spatial index against scanning the
+// entity lists of whole sectors, which is what World::entities did before.
+//
+//	$ entitybench [<archetype file>]
+
+#include "world.h"
+#include "sector.h"
+#include "entity.h"
+#include "archetypes.h"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// the world is this many sectors wide and high
+static const int worldSize = 40;
+static const int queries = 10000;
+
+// a screen's worth of tiles, and the vision range of characters
+static const int rectWidth = 80;
+static const int rectHeight = 50;
+static const double radius = 12;
+
+static vector<Entity*> scanSectors(World& w, int x1, int y1, int x2, int y2) {
+  vector<Entity*> ents;
+
+  for (int sy = y1 / Sector::size(); sy <= (y2 - 1) / Sector::size(); sy++) {
+    for (int sx = x1 / Sector::size(); sx <= (x2 - 1) / Sector::size();
+         sx++) {
+      Sector* s = w.sector(sx * Sector::size(), sy * Sector::size());
+
+      if (s == nullptr) {
+        continue;
+      }
+
+      for (Entity* e : s->entities()) {
+        if (e->x() >= x1 && e->x() < x2 && e->y() >= y1 && e->y() < y2) {
+          ents.push_back(e);
+        }
+      }
+    }
+  }
+
+  return ents;
+}
+
+static vector<Entity*> scanSectors(World& w, int x, int y, double range) {
+  const int r = static_cast<int>(range);
+  vector<Entity*> ents;
+
+  for (Entity* e : scanSectors(w, x - r, y - r, x + r + 1, y + r + 1)) {
+    if ((e->x() - x) * (e->x() - x) + (e->y() - y) * (e->y() - y) <=
+        range * range) {
+      ents.push_back(e);
+    }
+  }
+
+  return ents;
+}
+
+// runs the query at random positions and prints the time per query
+static void measure(string const& name, int w, int h,
+                    function<size_t(int, int)> query) {
+  srand(1);
+  size_t found = 0;
+
+  auto start = chrono::steady_clock::now();
+
+  for (int i = 0; i < queries; i++) {
+    found += query(rand() % (worldSize * Sector::size() - w),
+                   rand() % (worldSize * Sector::size() - h));
+  }
+
+  chrono::duration<double, micro> t = chrono::steady_clock::now() - start;
+
+  cout << "  " << left << setw(20) << name << right << setw(10) << fixed
+       << setprecision(2) << t.count() / queries << " us/query"
+       << setw(10) << setprecision(1) << double(found) / queries
+       << " entities/query" << endl;
+}
+
+static void bench(Archetypes const& archetypes, int entities) {
+  World world(worldSize, worldSize, archetypes);
+
+  srand(0);
+
+  for (int i = 0; i < entities; i++) {
+    world.spawn("goblin", rand() % (worldSize * Sector::size()),
+                rand() % (worldSize * Sector::size()));
+  }
+
+  cout << entities << " entities:" << endl;
+
+  measure("rect, index", rectWidth, rectHeight, [&](int x, int y) {
+    return world.entities(x, y, x + rectWidth, y + rectHeight).size();
+  });
+  measure("rect, sector scan", rectWidth, rectHeight, [&](int x, int y) {
+    return scanSectors(world, x, y, x + rectWidth, y + rectHeight).size();
+  });
+  measure("radius, index", 2 * radius, 2 * radius, [&](int x, int y) {
+    return world.entities(x + radius, y + radius, radius).size();
+  });
+  measure("radius, sector scan", 2 * radius, 2 * radius, [&](int x, int y) {
+    return scanSectors(world, x + radius, y + radius, radius).size();
+  });
+}
+
+int main(int argc, char* argv[]) {
+  Archetypes archetypes;
+
+  if (!archetypes.load(argc > 1 ? argv[1] : "archetypes.txt")) {
+    return 1;
+  }
+
+  bench(archetypes, 10000);
+  bench(archetypes, 100000);
+
+  return 0;
+}
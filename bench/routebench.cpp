@@ -0,0 +1,115 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares A* against jump point search on the usual terrain: node
+// expansions, time per route and the total cost of the routes found.
+//
+// Jump point search finds the cheapest routes. The A* of World::route
+// doesn't count the cost of the steps taken so far, so it expands fewer
+// nodes, but its routes may cost more. An expansion is a node taken off the
+// open list; jump point search also scans the tiles between jump points,
+// which isn't counted.
+//
+//	$ routebench [<archetype file>]
+
+#include "world.h"
+#include "sector.h"
+#include "archetypes.h"
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// the world is this many sectors wide and high
+static const int worldSize = 5;
+static const int routes = 200;
+
+// straight steps cost 2, diagonal ones 3
+static int cost(vector<Command> const& route) {
+  int c = 0;
+
+  for (Command step : route) {
+    int dx;
+    int dy;
+    offset(step, dx, dy);
+    c += (dx != 0 && dy != 0) ? 3 : 2;
+  }
+
+  return c;
+}
+
+static void measure(World& world, World::Pathfinder pathfinder,
+                    string const& name,
+                    vector<array<int, 4>> const& queries) {
+  world.setPathfinder(pathfinder);
+
+  size_t expansions = 0;
+  long totalCost = 0;
+  chrono::duration<double, milli> time(0);
+
+  for (auto const& q : queries) {
+    auto start = chrono::steady_clock::now();
+    vector<Command> route = world.route(q[0], q[1], q[2], q[3]);
+    time += chrono::steady_clock::now() - start;
+
+    expansions += world.routeExpansions();
+
+    if (route.front() != Command::none) {
+      totalCost += cost(route);
+    }
+  }
+
+  cout << left << setw(12) << name << right << setw(10) << fixed
+       << setprecision(3) << time.count() / queries.size() << " ms/route"
+       << setw(10) << setprecision(1) << double(expansions) / queries.size()
+       << " expansions/route" << setw(10) << totalCost << " total cost"
+       << endl;
+}
+
+int main(int argc, char* argv[]) {
+  Archetypes archetypes;
+
+  if (!archetypes.load(argc > 1 ? argv[1] : "archetypes.txt")) {
+    return 1;
+  }
+
+  srand(0);
+  World world(worldSize, worldSize, archetypes);
+
+  const int size = worldSize * Sector::size();
+  vector<array<int, 4>> queries;
+
+  while (queries.size() < routes) {
+    array<int, 4> q{{rand() % size, rand() % size, rand() % size,
+                     rand() % size}};
+
+    if (world.passable(q[0], q[1]) && world.passable(q[2], q[3])) {
+      queries.push_back(q);
+    }
+  }
+
+  cout << routes << " routes on " << size << "x" << size << " tiles:" << endl;
+
+  measure(world, World::Pathfinder::aStar, "A*", queries);
+  measure(world, World::Pathfinder::jumpPoint, "jump point", queries);
+
+  return 0;
+}
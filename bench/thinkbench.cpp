@@ -0,0 +1,131 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Times World::think against the number of npcs around the player. Npcs
+// the player can see think in full detail, all others in the active sectors
+// are only advanced coarsely, so the time per npc should depend on how many
+// of them are in view rather than on the population.
+//
+//	$ thinkbench [<archetype file>]
+
+#include "world.h"
+#include "sector.h"
+#include "player.h"
+#include "archetypes.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// the world is this many sectors wide and high; the player stands in the
+// middle one, so all sectors are awake
+static const int worldSize = 5;
+static const int warmupTurns = 10;
+static const int turns = 100;
+
+// number of npcs the player can see, which are all thought in full detail
+static size_t inView(World& world) {
+  Player const* player = world.player();
+  size_t n = 0;
+
+  for (Entity* e :
+       world.entities(player->x(), player->y(), player->visionRange())) {
+    if (e != player && player->los(*e)) {
+      n++;
+    }
+  }
+
+  return n;
+}
+
+// runs a turn and returns how long World::think took
+static chrono::duration<double, milli> turn(World& world) {
+  // keep the player alive, the npcs are usually hostile
+  world.player()->setHp(world.player()->maxHp());
+
+  world.letTimePass(1);
+
+  auto start = chrono::steady_clock::now();
+  world.think();
+  chrono::duration<double, milli> t = chrono::steady_clock::now() - start;
+
+  while (world.eventAvailable()) {
+    world.getEvent();
+  }
+
+  world.reclaim();
+
+  return t;
+}
+
+static void bench(Archetypes const& archetypes, int npcs) {
+  srand(0);
+
+  World world(worldSize, worldSize, archetypes);
+
+  // put the player on the first open tile right of the center
+  const int center = worldSize * Sector::size() / 2;
+  int x = center;
+
+  while (!world.passable(x, center)) {
+    x++;
+  }
+
+  world.player()->setXY(x, center);
+
+  // spread the npcs over the active sectors around the player
+  const int spread = 3 * Sector::size();
+  const int corner = center - spread / 2;
+
+  for (int i = 0; i < npcs; i++) {
+    world.spawn("goblin", corner + rand() % spread, corner + rand() % spread);
+  }
+
+  for (int i = 0; i < warmupTurns; i++) {
+    turn(world);
+  }
+
+  chrono::duration<double, milli> t(0);
+  size_t seen = 0;
+
+  for (int i = 0; i < turns; i++) {
+    t += turn(world);
+    seen += inView(world);
+  }
+
+  cout << setw(6) << npcs << setw(12) << fixed << setprecision(3)
+       << t.count() / turns << " ms/turn" << setw(10) << setprecision(2)
+       << 1000 * t.count() / turns / npcs << " us/npc" << setw(10)
+       << setprecision(1) << double(seen) / turns << " in view" << endl;
+}
+
+int main(int argc, char* argv[]) {
+  Archetypes archetypes;
+
+  if (!archetypes.load(argc > 1 ? argv[1] : "archetypes.txt")) {
+    return 1;
+  }
+
+  for (int npcs : {100, 200, 400, 800, 1600, 3200}) {
+    bench(archetypes, npcs);
+  }
+
+  return 0;
+}
@@ -3,6 +3,7 @@
 # SDL2_LIBRARY, the name of the library to link against
 # SDL2_FOUND, if false, do not try to link to SDL2
 # SDL2_INCLUDE_DIR, where to find SDL.h
+# SDL2_VERSION_STRING, the version of SDL2 found, e.g. "2.0.18"
 #
 # This module responds to the the flag:
 # SDL2_BUILDING_LIBRARY
@@ -160,4 +161,19 @@ ENDIF(SDL2_LIBRARY_TEMP)
 
 INCLUDE(FindPackageHandleStandardArgs)
 
-FIND_PACKAGE_HANDLE_STANDARD_ARGS(SDL2 REQUIRED_VARS SDL2_LIBRARY SDL2_INCLUDE_DIR)
+IF(SDL2_INCLUDE_DIR AND EXISTS "${SDL2_INCLUDE_DIR}/SDL_version.h")
+  FILE(STRINGS "${SDL2_INCLUDE_DIR}/SDL_version.h" SDL2_VERSION_LINES
+    REGEX "^#define[ \t]+SDL_(MAJOR_VERSION|MINOR_VERSION|PATCHLEVEL)[ \t]+[0-9]+$")
+
+  FOREACH(PART MAJOR_VERSION MINOR_VERSION PATCHLEVEL)
+    STRING(REGEX REPLACE ".*#define[ \t]+SDL_${PART}[ \t]+([0-9]+).*" "\\1"
+      SDL2_${PART} "${SDL2_VERSION_LINES}")
+  ENDFOREACH(PART)
+
+  SET(SDL2_VERSION_STRING
+    ${SDL2_MAJOR_VERSION}.${SDL2_MINOR_VERSION}.${SDL2_PATCHLEVEL})
+ENDIF(SDL2_INCLUDE_DIR AND EXISTS "${SDL2_INCLUDE_DIR}/SDL_version.h")
+
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(SDL2
+  REQUIRED_VARS SDL2_LIBRARY SDL2_INCLUDE_DIR
+  VERSION_VAR SDL2_VERSION_STRING)
@@ -31,6 +31,21 @@ enum class Command {
   southWest,
   MOVEMENT_END,
 
+  // keep in the same order as the movement commands
+  RUN_BEGIN,
+  runWest,
+  runSouth,
+  runNorth,
+  runEast,
+  runNorthEast,
+  runNorthWest,
+  runSouthEast,
+  runSouthWest,
+  RUN_END,
+
+  travel,
+  explore,
+
   wait,
   none,  // TODO replace with optional
 
@@ -41,6 +56,8 @@ enum class Command {
   drop,
   inventory,
   examine,
+  messageLog,
+  minimap,
 
   twoWeaponFightingToggle,
 
@@ -49,4 +66,36 @@ enum class Command {
   quit
 };
 
+// the coordinate offsets of a movement command
+inline void offset(Command direction, int& dx, int& dy) {
+  dx = 0;
+  dy = 0;
+
+  if (direction == Command::west || direction == Command::northWest ||
+      direction == Command::southWest) {
+    dx = -1;
+  } else if (direction == Command::east || direction == Command::northEast ||
+             direction == Command::southEast) {
+    dx = 1;
+  }
+
+  if (direction == Command::north || direction == Command::northWest ||
+      direction == Command::northEast) {
+    dy = -1;
+  } else if (direction == Command::south || direction == Command::southWest ||
+             direction == Command::southEast) {
+    dy = 1;
+  }
+}
+
+// the movement command for a step by the given offsets (each -1, 0 or 1)
+inline Command direction(int dx, int dy) {
+  static const Command directions[3][3] = {
+      {Command::northWest, Command::north, Command::northEast},
+      {Command::west, Command::wait, Command::east},
+      {Command::southWest, Command::south, Command::southEast}};
+
+  return directions[dy + 1][dx + 1];
+}
+
 #endif
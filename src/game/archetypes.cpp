@@ -0,0 +1,320 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "archetypes.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// reads a whole value; anything left over makes it invalid
+template <typename T>
+static bool read(istringstream& iss, T& value) {
+  return (iss >> value) && iss.peek() == EOF;
+}
+
+// true if archetypes of the kind can have the property
+static bool applies(string const& key, Archetype::Kind kind) {
+  const bool weapon = kind == Archetype::Kind::weapon;
+  const bool armor = kind == Archetype::Kind::armor;
+  const bool item = weapon || armor || kind == Archetype::Kind::item;
+
+  if (key == "hp") {
+    // armor is as sturdy as it protects
+    return !armor;
+  } else if (key == "density") {
+    // only monsters are kept up by the director
+    return kind == Archetype::Kind::monster;
+  } else if (key == "natural" || key == "inventory" || key == "speed" ||
+             key == "vision" || key == "attributes" || key == "bab") {
+    return !item;
+  } else if (key == "attack" || key == "crit" || key == "multiplier" ||
+             key == "verb") {
+    // the unarmed attack of characters
+    return !item || weapon;
+  } else if (key == "twohanded") {
+    return weapon;
+  } else if (key == "weight") {
+    return item;
+  } else if (key == "ac" || key == "maxdex" || key == "penalty" ||
+             key == "shield") {
+    return armor;
+  }
+
+  // size and unknown properties
+  return true;
+}
+
+bool Archetypes::load(string const& fileName) {
+  ifstream file(fileName);
+
+  if (!file.is_open()) {
+    cerr << "Error: could not open archetype file \"" << fileName << "\"\n";
+    return false;
+  }
+
+  string line;
+
+  for (int lineNo = 1; getline(file, line); lineNo++) {
+    istringstream iss(line);
+    string kind;
+
+    // skip empty lines and comments
+    if (!(iss >> kind) || kind.front() == '#') {
+      continue;
+    }
+
+    iss.seekg(0);
+
+    unique_ptr<Archetype> a = make_unique<Archetype>();
+    string error;
+
+    if (!parse(iss, *a, error)) {
+      cerr << "Error: " << fileName << ':' << lineNo << ": " << error << '\n';
+      return false;
+    }
+
+    if (_byName.count(a->name) != 0) {
+      cerr << "Error: " << fileName << ':' << lineNo
+           << ": duplicate archetype \"" << a->name << "\"\n";
+      return false;
+    }
+
+    _byName[a->name] = a.get();
+    _archetypes.push_back(move(a));
+  }
+
+  // items in inventories may be defined further down
+  for (auto const& a : _archetypes) {
+    for (string const& name : a->inventory) {
+      Archetype const* i = find(name);
+
+      if (i == nullptr || (i->kind != Archetype::Kind::item &&
+                           i->kind != Archetype::Kind::weapon &&
+                           i->kind != Archetype::Kind::armor)) {
+        cerr << "Error: " << fileName << ": \"" << name
+             << "\" in the inventory of \"" << a->name << "\" is not an item\n";
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+Archetype const* Archetypes::find(string const& name) const {
+  auto found = _byName.find(name);
+  return found != _byName.end() ? found->second : nullptr;
+}
+
+vector<Archetype const*> Archetypes::all() const {
+  vector<Archetype const*> all;
+
+  for (auto const& a : _archetypes) {
+    all.push_back(a.get());
+  }
+
+  return all;
+}
+
+bool Archetypes::parse(istream& line, Archetype& a, string& error) const {
+  static const unordered_map<string, Archetype::Kind> kinds = {
+      {"player", Archetype::Kind::player},
+      {"character", Archetype::Kind::character},
+      {"monster", Archetype::Kind::monster},
+      {"companion", Archetype::Kind::companion},
+      {"item", Archetype::Kind::item},
+      {"weapon", Archetype::Kind::weapon},
+      {"armor", Archetype::Kind::armor}};
+
+  static const unordered_map<string, Color> colors = {
+      {"black", Color::black},     {"red", Color::red},
+      {"green", Color::green},     {"yellow", Color::yellow},
+      {"blue", Color::blue},       {"magenta", Color::magenta},
+      {"cyan", Color::cyan},       {"white", Color::white}};
+
+  string kind;
+  string repr;
+  string color;
+  string prefix;
+  string description;
+
+  if (!(line >> kind >> a.name >> repr >> color >> prefix >> description)) {
+    error = "expected kind, name, char, color, prefix and description";
+    return false;
+  }
+
+  if (kinds.count(kind) == 0) {
+    error = "unknown kind \"" + kind + "\"";
+    return false;
+  }
+
+  a.kind = kinds.at(kind);
+
+  if (repr.size() != 1) {
+    error = "expected a single char instead of \"" + repr + "\"";
+    return false;
+  }
+
+  if (colors.count(color) == 0) {
+    error = "unknown color \"" + color + "\"";
+    return false;
+  }
+
+  prefix = (prefix == "-") ? "" : prefix + ' ';
+  replace(description.begin(), description.end(), '_', ' ');
+
+  // characters block the way, items don't
+  const bool item = a.kind == Archetype::Kind::item ||
+                    a.kind == Archetype::Kind::weapon ||
+                    a.kind == Archetype::Kind::armor;
+  a.tile = Tile(repr.front(), colors.at(color), prefix, description, true,
+                item);
+
+  if (item) {
+    a.size = Entity::Size::small;
+  }
+
+  string property;
+
+  while (line >> property) {
+    const size_t eq = property.find('=');
+    const string key = property.substr(0, eq);
+    const string value = (eq != string::npos) ? property.substr(eq + 1) : "";
+
+    if (!setProperty(key, value, a, error)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Archetypes::setProperty(string const& key, string const& value,
+                             Archetype& a, string& error) const {
+  static const unordered_map<string, Entity::Size> sizes = {
+      {"colossal", Entity::Size::colossal},
+      {"gargantuan", Entity::Size::gargantuan},
+      {"huge", Entity::Size::huge},
+      {"large", Entity::Size::large},
+      {"medium", Entity::Size::medium},
+      {"small", Entity::Size::small},
+      {"tiny", Entity::Size::tiny},
+      {"diminutive", Entity::Size::diminutive},
+      {"fine", Entity::Size::fine}};
+
+  if (!applies(key, a.kind)) {
+    error = "\"" + key + "\" doesn't apply to this kind of archetype";
+    return false;
+  }
+
+  istringstream iss(value);
+  Attack const& attack = a.attack;
+  bool ok = true;
+
+  if (key == "hp") {
+    ok = Dice::parse(value, a.hp);
+  } else if (key == "size") {
+    ok = sizes.count(value) != 0;
+
+    if (ok) {
+      a.size = sizes.at(value);
+    }
+  } else if (key == "density") {
+    ok = read(iss, a.density) && a.density >= 0;
+  } else if (key == "natural") {
+    ok = read(iss, a.naturalArmor) && a.naturalArmor >= 0;
+  } else if (key == "inventory") {
+    string name;
+
+    while (getline(iss, name, ',')) {
+      a.inventory.push_back(name);
+    }
+  } else if (key == "speed") {
+    // npcs take speed / elapsed steps
+    ok = read(iss, a.speed) && a.speed > 0;
+  } else if (key == "vision") {
+    ok = read(iss, a.visionRange) && a.visionRange >= 0;
+  } else if (key == "attributes") {
+    // comma separated, e.g. 10,12,10,8,11,9
+    for (size_t i = 0; ok && i < a.attributes.size(); i++) {
+      char comma = ',';
+      ok = (i == 0 || ((iss >> comma) && comma == ',')) &&
+           (iss >> a.attributes[i]);
+    }
+
+    ok = ok && iss.peek() == EOF;
+  } else if (key == "bab") {
+    ok = read(iss, a.bab);
+  } else if (key == "attack") {
+    Dice damage;
+    ok = Dice::parse(value, damage);
+
+    if (ok) {
+      a.attack = Attack(damage, attack.critRange(), attack.critMultiplier(),
+                        attack.critVerb(), attack.range());
+    }
+  } else if (key == "crit") {
+    int critRange;
+    ok = read(iss, critRange) && critRange >= 1 && critRange <= 20;
+
+    if (ok) {
+      a.attack = Attack(attack.damageDice(), critRange, attack.critMultiplier(),
+                        attack.critVerb(), attack.range());
+    }
+  } else if (key == "multiplier") {
+    int multiplier;
+    ok = read(iss, multiplier) && multiplier >= 1;
+
+    if (ok) {
+      a.attack = Attack(attack.damageDice(), attack.critRange(), multiplier,
+                        attack.critVerb(), attack.range());
+    }
+  } else if (key == "verb") {
+    ok = !value.empty();
+
+    if (ok) {
+      a.attack = Attack(attack.damageDice(), attack.critRange(),
+                        attack.critMultiplier(), value, attack.range());
+    }
+  } else if (key == "twohanded") {
+    ok = value.empty();
+    a.twoHanded = true;
+  } else if (key == "weight") {
+    ok = read(iss, a.weight) && a.weight >= 0;
+  } else if (key == "ac") {
+    ok = read(iss, a.ac) && a.ac >= 0;
+  } else if (key == "maxdex") {
+    ok = read(iss, a.maxDexBon) && a.maxDexBon >= 0;
+  } else if (key == "penalty") {
+    ok = read(iss, a.checkPenalty);
+  } else if (key == "shield") {
+    ok = value.empty();
+    a.shield = true;
+  } else {
+    error = "unknown property \"" + key + "\"";
+    return false;
+  }
+
+  if (!ok) {
+    error = "invalid value \"" + value + "\" for \"" + key + "\"";
+  }
+
+  return ok;
+}
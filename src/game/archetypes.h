@@ -0,0 +1,114 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ARCHETYPES_H
+#define ARCHETYPES_H
+
+#include "tile.h"
+#include "dice.h"
+#include "attack.h"
+#include "entity.h"
+#include "character.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/*!
+ * \brief A kind of character or item, everything needed to spawn one.
+ */
+struct Archetype {
+  enum class Kind {
+    player,
+    character,  // doesn't act on its own
+    monster,    // an npc following nobody
+    companion,  // an npc following the player
+    item,
+    weapon,
+    armor
+  };
+
+  string name;
+  Kind kind;
+  Tile tile;
+
+  Dice hp{1, 1, 0};
+  Entity::Size size{Entity::Size::medium};
+  // average number per sector kept up by the Director
+  double density{0};
+  int naturalArmor{0};
+  // names of the archetypes of the items an entity starts out with
+  vector<string> inventory;
+
+  // characters
+  double speed{1};
+  int visionRange{12};
+  array<int, Character::noOfAttributes> attributes{{10, 10, 10, 10, 10, 10}};
+  int bab{0};
+
+  // unarmed attack of characters, attack of weapons
+  Attack attack{{1, 2, 0}};
+  bool twoHanded{false};
+
+  // items
+  double weight{0};
+
+  // armor
+  int ac{0};
+  int maxDexBon{999};
+  int checkPenalty{0};
+  bool shield{false};
+};
+
+/*!
+ * \brief A table of archetypes, read from a file.
+ *
+ * Every line of the file describes one archetype:
+ *
+ *	<kind> <name> <char> <color> <prefix> <description> {<property>}
+ *
+ * where underscores in the description stand for spaces, and a prefix of
+ * "-" means there is none. Properties are either flags (e.g. "shield") or
+ * of the form "<key>=<value>", e.g. "hp=1d8+2". Empty lines and lines
+ * starting with '#' are ignored.
+ */
+class Archetypes {
+ public:
+  // prints an error and returns false if the file isn't valid
+  bool load(string const& fileName);
+
+  // nullptr if there is no such archetype
+  Archetype const* find(string const& name) const;
+
+  vector<Archetype const*> all() const;
+
+ private:
+  bool parse(istream& line, Archetype& a, string& error) const;
+  bool setProperty(string const& key, string const& value, Archetype& a,
+                   string& error) const;
+
+  // entities refer to the tiles, so the archetypes must never move
+  vector<unique_ptr<Archetype>> _archetypes;
+  unordered_map<string, Archetype const*> _byName;
+};
+
+#endif
@@ -18,7 +18,7 @@
 
 #include "attack.h"
 
-Attack::Attack(int (*damage)(), int critRange, int critMultiplier,
+Attack::Attack(Dice damage, int critRange, int critMultiplier,
                string critVerb, double range)
     : _damage(damage),
       _range(range),
@@ -28,10 +28,12 @@ Attack::Attack(int (*damage)(), int critRange, int critMultiplier,
 
 double Attack::range() const { return _range; }
 
-int Attack::damage() const { return _damage(); }
+int Attack::damage() const { return _damage.roll(); }
 
-int Attack::critRange() { return _critRange; }
+Dice Attack::damageDice() const { return _damage; }
 
-int Attack::critMultiplier() { return _critMultiplier; }
+int Attack::critRange() const { return _critRange; }
 
-string Attack::critVerb() { return _critVerb; }
+int Attack::critMultiplier() const { return _critMultiplier; }
+
+string Attack::critVerb() const { return _critVerb; }
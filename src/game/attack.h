@@ -19,13 +19,14 @@
 #ifndef ATTACK_H
 #define ATTACK_H
 
+#include "dice.h"
 #include <string>
 
 using namespace std;
 
 class Attack {
  private:
-  int (*_damage)();  // damage function
+  Dice _damage;
   double _range;
 
   int _critRange;       // minimum result to score a critical hit
@@ -34,14 +35,15 @@ class Attack {
   string _critVerb;  // word used to describe a critical hit
 
  public:
-  Attack(int (*damage)(), int critRange = 20, int critMultiplier = 2,
+  Attack(Dice damage, int critRange = 20, int critMultiplier = 2,
          string critVerb = "maim", double range = 1.5);
 
   int damage() const;
+  Dice damageDice() const;
   double range() const;
-  int critRange();
-  int critMultiplier();
-  string critVerb();
+  int critRange() const;
+  int critMultiplier() const;
+  string critVerb() const;
 };
 
 #endif
@@ -0,0 +1,503 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "autosave.h"
+#include "world.h"
+#include "sector.h"
+#include "entity.h"
+#include "character.h"
+#include "player.h"
+#include "item.h"
+#include "grounditem.h"
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+const int Autosave::_turnsBetweenSaves = 20;
+const int Autosave::_deltasBetweenCompactions = 32;
+
+bool Autosave::SavedItem::operator==(SavedItem const& rhs) const {
+  return tile == rhs.tile && hp == rhs.hp && count == rhs.count;
+}
+
+bool Autosave::SavedEntity::operator==(SavedEntity const& rhs) const {
+  return kind == rhs.kind && tile == rhs.tile && x == rhs.x && y == rhs.y &&
+         hp == rhs.hp && count == rhs.count && inventory == rhs.inventory;
+}
+
+bool Autosave::ItemRecord::operator==(ItemRecord const& rhs) const {
+  return tile == rhs.tile && hp == rhs.hp && count == rhs.count;
+}
+
+bool Autosave::EntityRecord::operator==(EntityRecord const& rhs) const {
+  return tile == rhs.tile && x == rhs.x && y == rhs.y && hp == rhs.hp &&
+         count == rhs.count && player == rhs.player &&
+         inventory == rhs.inventory;
+}
+
+Autosave::Autosave(string const& fileName)
+    : _fileName(fileName), _deltas(_deltasBetweenCompactions) {
+  // The log of the previous game is kept until the first full save replaces
+  // it, so it is only checked for being writable here.
+  if (!ofstream(fileName, ios::app).is_open()) {
+    cerr << "Error: could not open autosave file \"" << fileName << "\"\n";
+    return;
+  }
+
+  _worker = thread(&Autosave::work, this);
+}
+
+Autosave::~Autosave() {
+  if (!_worker.joinable()) {
+    return;
+  }
+
+  {
+    lock_guard<mutex> lock(_mutex);
+    _stop = true;
+  }
+
+  _wakeUp.notify_one();
+  _worker.join();
+}
+
+bool Autosave::good() const { return _worker.joinable(); }
+
+Autosave::EntityRecord Autosave::record(World const& world, Entity const* e) {
+  EntityRecord r{&e->t(), e->x(), e->y(), e->hp(), 0, e == world.player(),
+                 {}};
+
+  if (Character const* c = dynamic_cast<Character const*>(e)) {
+    for (Item const* i : c->inventory()) {
+      r.inventory.push_back({&i->t(), i->hp(), i->count()});
+    }
+  }
+
+  return r;
+}
+
+void Autosave::endTurn(World const& world) {
+  if (!good() || ++_turns % _turnsBetweenSaves != 0) {
+    return;
+  }
+
+  unique_ptr<Job> job(new Job{world.snapshot(), {}});
+  _changes.resize(world.width() * world.height());
+
+  for (int sy = 0; sy < world.height(); sy++) {
+    for (int sx = 0; sx < world.width(); sx++) {
+      const int i = sx + sy * world.width();
+      Sector const* s = world.sector(sx * Sector::size(), sy * Sector::size());
+
+      // only changed sectors are copied; sectors never changed are empty
+      if (s->changes() == _changes[i]) {
+        continue;
+      }
+
+      _changes[i] = s->changes();
+      auto& records = job->entities[i];
+
+      for (Entity const* e : s->entities()) {
+        records.push_back(record(world, e));
+      }
+
+      for (auto const& pile : s->items()) {
+        const int x = sx * Sector::size() + pile.first % Sector::size();
+        const int y = sy * Sector::size() + pile.first / Sector::size();
+
+        for (GroundItem const& i : pile.second) {
+          records.push_back({&i.tile(), x, y, i.hp, i.count, false, {}});
+        }
+      }
+    }
+  }
+
+  {
+    lock_guard<mutex> lock(_mutex);
+
+    if (_pending) {
+      // the job was never taken, but its sectors still have to be saved
+      for (auto& entities : _pending->entities) {
+        job->entities.insert(move(entities));
+      }
+    }
+
+    _pending = move(job);
+  }
+
+  _wakeUp.notify_one();
+}
+
+void Autosave::work() {
+  for (;;) {
+    unique_ptr<Job> job;
+
+    {
+      unique_lock<mutex> lock(_mutex);
+      _wakeUp.wait(lock, [this]() { return _stop || _pending; });
+
+      // finish the last save before stopping
+      if (!_pending) {
+        return;
+      }
+
+      job = move(_pending);
+    }
+
+    _entities.resize(job->snapshot.width() * job->snapshot.height());
+
+    for (auto& entities : job->entities) {
+      _entities[entities.first] = move(entities.second);
+    }
+
+    if (_deltas >= _deltasBetweenCompactions) {
+      compact(job->snapshot);
+    } else {
+      write(job->snapshot);
+    }
+  }
+}
+
+void Autosave::write(Snapshot const& snapshot) {
+  const int sectors = snapshot.width() * snapshot.height();
+
+  // nothing saved yet, so everything has changed
+  _width = snapshot.width();
+  _saved.resize(sectors);
+  _savedEntities.resize(sectors);
+
+  _log << "turn " << snapshot.time() << '\n';
+
+  for (int sy = 0; sy < snapshot.height(); sy++) {
+    for (int sx = 0; sx < snapshot.width(); sx++) {
+      const int i = sx + sy * snapshot.width();
+      Sector::Pages const& pages =
+          *snapshot.pages(sx * Sector::size(), sy * Sector::size());
+
+      // the sector has to copy its pages before changing them, so unchanged
+      // sectors still share them with the last save
+      const bool tilesChanged = pages.tiles != _saved[i].tiles;
+      const bool exploredChanged =
+          pages.exploredBits != _saved[i].exploredBits;
+      const bool entitiesChanged = _entities[i] != _savedEntities[i];
+
+      if (!tilesChanged && !exploredChanged && !entitiesChanged) {
+        continue;
+      }
+
+      // register new kinds of tiles before they are used
+      if (tilesChanged) {
+        for (Tile const* t : *pages.tiles) {
+          tileId(t);
+        }
+      }
+
+      for (EntityRecord const& e : _entities[i]) {
+        tileId(e.tile);
+
+        for (ItemRecord const& item : e.inventory) {
+          tileId(item.tile);
+        }
+      }
+
+      _log << "sector " << sx << ' ' << sy << '\n';
+
+      if (tilesChanged) {
+        _log << "tiles";
+
+        auto const& tiles = *pages.tiles;
+
+        for (size_t j = 0; j < tiles.size();) {
+          size_t k = j;
+
+          while (k < tiles.size() && tiles[k] == tiles[j]) {
+            k++;
+          }
+
+          _log << ' ' << k - j << ' ' << tileId(tiles[j]);
+          j = k;
+        }
+
+        _log << '\n';
+      }
+
+      if (exploredChanged) {
+        _log << "explored" << hex;
+
+        for (uint64_t word : *pages.exploredBits) {
+          _log << ' ' << word;
+        }
+
+        _log << dec << '\n';
+      }
+
+      if (entitiesChanged) {
+        _log << "entities " << _entities[i].size() << '\n';
+
+        for (EntityRecord const& e : _entities[i]) {
+          SavedEntity const s = saved(e);
+
+          _log << s.kind << ' ' << s.tile << ' ' << s.x << ' ' << s.y << ' '
+               << s.hp;
+
+          if (s.count > 0) {
+            _log << ' ' << s.count;
+          }
+
+          _log << '\n';
+
+          for (SavedItem const& item : s.inventory) {
+            _log << "carries " << item.tile << ' ' << item.hp << ' '
+                 << item.count << '\n';
+          }
+        }
+      }
+
+      _saved[i] = pages;
+      _savedEntities[i] = _entities[i];
+    }
+  }
+
+  _log << "end" << endl;
+  _deltas++;
+}
+
+void Autosave::compact(Snapshot const& snapshot) {
+  // nothing has been written to the log of a previous game
+  if (!_saved.empty()) {
+    check();
+  }
+
+  // write a full save next to the log and replace the log with it, so there
+  // always is a complete save on disk
+  string const tmpName = _fileName + ".tmp";
+
+  _log.close();
+  _log.open(tmpName, ios::trunc);
+
+  _saved.clear();
+  _savedEntities.clear();
+  _tileIds.clear();
+
+  write(snapshot);
+  _log.close();
+
+  if (rename(tmpName.c_str(), _fileName.c_str()) != 0) {
+    cerr << "Error: could not replace autosave file \"" << _fileName
+         << "\"\n";
+  }
+
+  _log.open(_fileName, ios::app);
+  _deltas = 0;
+}
+
+void Autosave::check() {
+  SavedWorld world;
+
+  if (!read(_fileName, world)) {
+    return;
+  }
+
+  bool matches = world.sectors.size() == _saved.size();
+
+  for (auto const& t : _tileIds) {
+    auto found = world.tiles.find(t.second);
+
+    if (found == world.tiles.end() || found->second.first != t.first->repr()) {
+      matches = false;
+    }
+  }
+
+  for (size_t i = 0; i < _saved.size() && matches; i++) {
+    auto found = world.sectors.find(
+        {static_cast<int>(i % _width), static_cast<int>(i / _width)});
+
+    if (found == world.sectors.end()) {
+      matches = false;
+      break;
+    }
+
+    SavedSector const& s = found->second;
+    auto const& tiles = *_saved[i].tiles;
+
+    matches = s.tiles.size() == tiles.size() &&
+              s.explored == *_saved[i].exploredBits &&
+              s.entities.size() == _savedEntities[i].size();
+
+    for (size_t j = 0; j < tiles.size() && matches; j++) {
+      matches = s.tiles[j] == _tileIds.at(tiles[j]);
+    }
+
+    for (size_t j = 0; j < s.entities.size() && matches; j++) {
+      matches = s.entities[j] == saved(_savedEntities[i][j]);
+    }
+  }
+
+  if (!matches) {
+    cerr << "Error: autosave file \"" << _fileName
+         << "\" doesn't match the saved world\n";
+  }
+}
+
+bool Autosave::read(string const& fileName, SavedWorld& world) {
+  ifstream in(fileName);
+
+  if (!in.is_open()) {
+    cerr << "Error: could not open autosave file \"" << fileName << "\"\n";
+    return false;
+  }
+
+  // Blocks are applied once they are complete. Sectors without changed
+  // tiles or explored bits are left empty, changed entities are marked.
+  double time = 0;
+  map<pair<int, int>, SavedSector> changed;
+  map<pair<int, int>, bool> entitiesChanged;
+  pair<int, int> pos;
+  SavedSector* sector = nullptr;
+  vector<SavedEntity>* entities = nullptr;
+
+  string line;
+  int lineNo = 0;
+
+  while (getline(in, line)) {
+    lineNo++;
+
+    istringstream iss(line);
+    string key;
+    iss >> key;
+
+    bool ok = true;
+
+    if (key == "turn") {
+      ok = bool(iss >> time);
+    } else if (key == "tile") {
+      // the description may contain spaces, the char may be one
+      int id;
+      string desc;
+      ok = (iss >> id) && iss.get() == ' ';
+
+      const char repr = iss.get();
+      ok = ok && iss.get() == ' ';
+      getline(iss, desc);
+
+      world.tiles[id] = {repr, desc};
+    } else if (key == "sector") {
+      ok = bool(iss >> pos.first >> pos.second);
+
+      sector = &changed[pos];
+      entities = nullptr;
+    } else if (key == "tiles" && sector != nullptr) {
+      int count;
+      int id;
+
+      while (iss >> count >> id) {
+        sector->tiles.insert(sector->tiles.end(), count, id);
+      }
+
+      ok = sector->tiles.size() ==
+           static_cast<size_t>(Sector::size() * Sector::size());
+    } else if (key == "explored" && sector != nullptr) {
+      uint64_t word;
+
+      while (iss >> hex >> word) {
+        sector->explored.push_back(word);
+      }
+    } else if (key == "entities" && sector != nullptr) {
+      size_t count;
+      ok = bool(iss >> count);
+
+      entitiesChanged[pos] = true;
+      entities = &sector->entities;
+      entities->reserve(count);
+    } else if ((key == "entity" || key == "player" || key == "item") &&
+               entities != nullptr) {
+      SavedEntity e{key, 0, 0, 0, 0, 0, {}};
+      ok = bool(iss >> e.tile >> e.x >> e.y >> e.hp);
+
+      if (key == "item") {
+        ok = ok && (iss >> e.count);
+      }
+
+      entities->push_back(e);
+    } else if (key == "carries" && entities != nullptr &&
+               !entities->empty()) {
+      SavedItem i;
+      ok = bool(iss >> i.tile >> i.hp >> i.count);
+
+      entities->back().inventory.push_back(i);
+    } else if (key == "end") {
+      for (auto& s : changed) {
+        SavedSector& saved = world.sectors[s.first];
+
+        if (!s.second.tiles.empty()) {
+          saved.tiles = move(s.second.tiles);
+        }
+
+        if (!s.second.explored.empty()) {
+          saved.explored = move(s.second.explored);
+        }
+
+        if (entitiesChanged[s.first]) {
+          saved.entities = move(s.second.entities);
+        }
+      }
+
+      world.time = time;
+      changed.clear();
+      entitiesChanged.clear();
+      sector = nullptr;
+      entities = nullptr;
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      cerr << "Error: line " << lineNo << " of autosave file \"" << fileName
+           << "\" is malformed\n";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int Autosave::tileId(Tile const* tile) {
+  auto found = _tileIds.find(tile);
+
+  if (found != _tileIds.end()) {
+    return found->second;
+  }
+
+  const int id = _tileIds.size();
+  _tileIds[tile] = id;
+
+  _log << "tile " << id << ' ' << tile->repr() << ' ' << tile->desc() << '\n';
+
+  return id;
+}
+
+Autosave::SavedEntity Autosave::saved(EntityRecord const& e) const {
+  SavedEntity s{e.count > 0 ? "item" : (e.player ? "player" : "entity"),
+                _tileIds.at(e.tile), e.x, e.y, e.hp, e.count, {}};
+
+  for (ItemRecord const& i : e.inventory) {
+    s.inventory.push_back({_tileIds.at(i.tile), i.hp, i.count});
+  }
+
+  return s;
+}
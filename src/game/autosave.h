@@ -0,0 +1,198 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include "snapshot.h"
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class World;
+class Entity;
+class Tile;
+
+/*!
+ * \brief Periodically saves the world on a background thread.
+ *
+ * All the main thread does is take a snapshot of the world and copy the
+ * entities of the sectors which changed since the last save, as counted by
+ * Sector::changes(). The background thread compares this to what it has
+ * saved before and appends only the changed sectors to the log. Unchanged
+ * terrain is recognized by its pages, which are shared with the previous
+ * snapshot. Once enough deltas have piled up, the log is read back, checked
+ * against what has been saved and compacted into a single full save.
+ *
+ * The first save of a game is a full one, which replaces the log of the
+ * previous game only once it is complete.
+ *
+ * The log is a text file made up of blocks like the following:
+ *
+ *	turn <time>
+ *	tile <id> <char> <description>	(once for every new kind of tile)
+ *	sector <x> <y>
+ *	tiles {<count> <tile id>}	(run length encoded, if changed)
+ *	explored {<hex word>}	(if changed)
+ *	entities <count>	(if changed, followed by as many entity, player or
+ *				item lines)
+ *	entity <tile id> <x> <y> <hp>
+ *	player <tile id> <x> <y> <hp>
+ *	carries <tile id> <hp> <count>	(in the inventory of the character
+ *					above)
+ *	item <tile id> <x> <y> <hp> <count>	(lying on the ground)
+ *	end
+ */
+class Autosave {
+ public:
+  // an item in an inventory as read back from a log
+  struct SavedItem {
+    int tile;
+    int hp;
+    int count;
+
+    bool operator==(SavedItem const& rhs) const;
+  };
+
+  // an entity, the player or a stack on the ground as read back from a log
+  struct SavedEntity {
+    string kind;  // "entity", "player" or "item"
+    int tile;
+    int x;
+    int y;
+    int hp;
+    int count;  // of a stack on the ground, 0 for all other entities
+    vector<SavedItem> inventory;
+
+    bool operator==(SavedEntity const& rhs) const;
+  };
+
+  struct SavedSector {
+    vector<int> tiles;  // tile ids, row for row
+    vector<uint64_t> explored;
+    vector<SavedEntity> entities;
+  };
+
+  // the state of the world as of the last complete save in a log
+  struct SavedWorld {
+    double time{0};
+    // repr and description of every tile id
+    map<int, pair<char, string>> tiles;
+    map<pair<int, int>, SavedSector> sectors;
+  };
+
+  Autosave(string const& fileName);
+  ~Autosave();
+
+  // false if the log couldn't be opened
+  bool good() const;
+
+  // has to be called at the end of every turn
+  void endTurn(World const& world);
+
+  /*!
+   * \brief Reads a log back.
+   *
+   * A block which has been cut off, e.g. by a crash, is ignored.
+   *
+   * \return false if the file couldn't be read or is malformed.
+   */
+  static bool read(string const& fileName, SavedWorld& world);
+
+ private:
+  struct ItemRecord {
+    Tile const* tile;
+    int hp;
+    int count;
+
+    bool operator==(ItemRecord const& rhs) const;
+  };
+
+  struct EntityRecord {
+    Tile const* tile;
+    int x;
+    int y;
+    int hp;
+    int count;  // of a stack on the ground, 0 for all other entities
+    bool player;
+    vector<ItemRecord> inventory;
+
+    bool operator==(EntityRecord const& rhs) const;
+  };
+
+  struct Job {
+    Snapshot snapshot;
+    // the entities of the sectors which changed, by sector index
+    unordered_map<int, vector<EntityRecord>> entities;
+  };
+
+  static EntityRecord record(World const& world, Entity const* e);
+
+  void work();
+  void write(Snapshot const& snapshot);
+  void compact(Snapshot const& snapshot);
+  // reads the log back and compares it to what has been written
+  void check();
+
+  int tileId(Tile const* tile);
+  SavedEntity saved(EntityRecord const& e) const;
+
+  string _fileName;
+
+  // only touched by the main thread
+  int _turns{0};
+  // Sector::changes() of every sector when it was last copied
+  vector<unsigned long> _changes;
+
+  // only touched by the background thread
+  ofstream _log;
+  int _deltas;
+  // of the world in sectors
+  size_t _width{0};
+  // the latest known entities of every sector
+  vector<vector<EntityRecord>> _entities;
+  vector<Sector::Pages> _saved;
+  vector<vector<EntityRecord>> _savedEntities;
+  unordered_map<Tile const*, int> _tileIds;
+
+  thread _worker;
+
+  // everything below is guarded by _mutex
+  mutex _mutex;
+  condition_variable _wakeUp;
+  bool _stop{false};
+
+  // Only the latest job is kept; older ones would be outdated anyway. The
+  // entities of sectors which haven't changed since are carried over.
+  unique_ptr<Job> _pending;
+
+  static const int _turnsBetweenSaves;
+  static const int _deltasBetweenCompactions;
+};
+
+#endif
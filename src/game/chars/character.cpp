@@ -21,7 +21,8 @@
 #include "sector.h"
 #include "yarlconfig.h"
 #include "player.h"
-#include <attackevent.h>
+#include "item.h"
+#include "dropevent.h"
 #include <cstdlib>
 #include <cmath>  // for pow
 
@@ -30,14 +31,17 @@ using namespace std;
 Character::Character(const Tile& t, int hp, int x, int y, double speed,
                      int visionRange,
                      const array<int, noOfAttributes>& attributes, World& world,
-                     Attack* unarmed, const list<Item*>& inventory, int bab,
-                     Character::Size s, int naturalArmor)
-    : Entity(t, hp, x, y, world, s, naturalArmor, inventory),
+                     Attack const* unarmed, const list<Item*>& inventory,
+                     int bab, Character::Size s, int naturalArmor)
+    : Entity(t, hp, x, y, world, s, naturalArmor),
       _visionRange(visionRange),
       _unarmed(unarmed),
       _speed(speed),
       _bab(bab),
-      _attributes(attributes) {}
+      _inventory(inventory),
+      _attributes(attributes) {
+  updateLoad();
+}
 
 bool Character::move(int dx, int dy) {
   if (world().passable(x() + dx, y() + dy)) {
@@ -48,44 +52,53 @@ bool Character::move(int dx, int dy) {
   return false;
 }
 
-void Character::attack(Entity* target) {
-  _lastTarget = target;
-  target->setLastAttacker(this);
+const Inventory& Character::inventory() const { return _inventory; }
 
-  // hit roll
-  int toHitMod = _bab + attributeMod(strength) + size();
-  int hitRoll = rand() % 20 + 1;
+Item* Character::addItem(Item* i) {
+  Item* stack = _inventory.stackFor(i);
 
-  if (World::distance(x(), y(), target->x(), target->y()) <=
-          _unarmed->range() &&
-      hitRoll + toHitMod >= target->armorClass()) {
-    bool crit = false;
-    int damage = _unarmed->damage() + attributeMod(strength);
+  if (stack != nullptr) {
+    _inventory.grow(stack, i->count());
+    world().retire(i);
+  } else {
+    _inventory.add(i);
+    stack = i;
+  }
 
-    if (hitRoll >=
-        _unarmed->critRange()) {  // check if there is a potential crit
-      crit = rand() % 20 + 1 + toHitMod >= target->armorClass();
+  inventoryChanged();
+  return stack;
+}
 
-      if (crit) {  // confirm crit
-        for (int i = 1; i < _unarmed->critMultiplier(); i++) {
-          damage += _unarmed->damage() + attributeMod(strength);
-        }
-      }
-    }
+bool Character::removeItem(Item* i) {
+  if (!_inventory.remove(i)) {
+    return false;
+  }
 
-    world().addEvent(std::make_unique<AttackEvent>(*this, *target, true));
+  unequip(i);
+  inventoryChanged();
+  return true;
+}
 
-    if (damage <= 0) {  // hits inflict at least 1 hp damage
-      damage = 1;
-    }
+double Character::inventoryWeight() const { return _inventory.weight(); }
 
-    target->setHp(target->hp() - damage);
-    return;
-  } else {  // don't do any damage on miss
-    world().addEvent(std::make_unique<AttackEvent>(*this, *target, false));
+void Character::dropItems() {
+  vector<Item*> dropped(_inventory.begin(), _inventory.end());
+  _inventory.clear();
+
+  for (Item* i : dropped) {
+    unequip(i);
+  }
+
+  inventoryChanged();
+
+  for (Item* i : dropped) {
+    world().putItem(i, x(), y());
+    world().addEvent(std::make_unique<DropEvent>(*this, *i));
   }
 }
 
+void Character::attack(Entity* target) { Combat::attack(*this, *target); }
+
 bool Character::los(int x, int y, double factor) const {
   return world().los(this->x(), this->y(), x, y, _visionRange * factor);
 }
@@ -98,9 +111,7 @@ bool Character::los(Entity const& e, double factor) const {
 vector<Entity*> Character::seenEntities() {
   vector<Entity*> ents;
 
-  for (Entity* e :
-       world().entities(x() - visionRange(), y() - visionRange(),
-                        x() + visionRange() + 1, y() + visionRange() + 1))
+  for (Entity* e : world().entities(x(), y(), visionRange()))
     if (los(*e)) {
       ents.push_back(e);
     }
@@ -108,16 +119,42 @@ vector<Entity*> Character::seenEntities() {
   return ents;
 }
 
-int Character::armorClass() {
-  return 10 + attributeMod(dexterity) + size() + naturalArmor() +
-         (_armor == nullptr ? 0 : _armor->ac());
+int Character::armorClass() { return combatStats().armorClass; }
+
+const CombatStats& Character::combatStats() {
+  if (!_combatStatsValid) {
+    _combatStats = computeCombatStats();
+    _combatStatsValid = true;
+  }
+
+  return _combatStats;
 }
 
-Attack* Character::unarmed() { return _unarmed; }
+void Character::invalidateCombatStats() { _combatStatsValid = false; }
+
+CombatStats Character::computeCombatStats() {
+  CombatStats stats;
+
+  stats.armorClass = 10 + attributeMod(dexterity) + size() + naturalArmor() +
+                     (_armor == nullptr ? 0 : _armor->ac());
+
+  // unarmed attack
+  stats.strikes[0] = {_unarmed, _bab + attributeMod(strength) + size(),
+                      attributeMod(strength), _unarmed->critRange(),
+                      _unarmed->critMultiplier()};
+  stats.noOfStrikes = 1;
+
+  return stats;
+}
+
+Attack const* Character::unarmed() { return _unarmed; }
 
 Armor* Character::armor() const { return _armor; }
 
-void Character::setArmor(Armor* armor) { _armor = armor; }
+void Character::setArmor(Armor* armor) {
+  _armor = armor;
+  invalidateCombatStats();
+}
 
 int Character::attribute(Character::Attribute attribute) {
   return _attributes[attribute];
@@ -153,16 +190,6 @@ int Character::visionRange() const { return _visionRange; }
 
 double Character::speed() const { return _speed; }
 
-double Character::inventoryWeight() {
-  double weight = 0;
-
-  for (Item* i : inventory()) {
-    weight += i->weight();
-  }
-
-  return weight;
-}
-
 double Character::lightLoad() { return heavyLoad() / 3; }
 
 double Character::mediumLoad() { return heavyLoad() * 2 / 3; }
@@ -175,18 +202,35 @@ double Character::heavyLoad() {
   }
 }
 
-Character::Load Character::load() {
+Character::Load Character::load() { return _load; }
+
+void Character::updateLoad() {
   double weight = inventoryWeight();
 
   if (weight > heavyLoad()) {
-    return Load::overloaded;
+    _load = Load::overloaded;
   } else if (weight > mediumLoad()) {
-    return Load::heavy;
+    _load = Load::heavy;
   } else if (weight > lightLoad()) {
-    return Load::medium;
+    _load = Load::medium;
   } else {
-    return Load::light;
+    _load = Load::light;
+  }
+}
+
+void Character::unequip(Item* i) {
+  if (_armor == i) {
+    setArmor(nullptr);
+  }
+}
+
+void Character::inventoryChanged() {
+  if (sector() != nullptr) {
+    sector()->markChanged();
   }
+
+  updateLoad();
+  invalidateCombatStats();
 }
 
 int Character::loadMaxDexBon() {
@@ -225,4 +269,12 @@ Entity* Character::lastTarget() const { return _lastTarget; }
 
 void Character::setLastTarget(Entity* lastTarget) { _lastTarget = lastTarget; }
 
+void Character::forget(Entity const* other) {
+  if (_lastTarget == other) {
+    _lastTarget = nullptr;
+  }
+
+  Entity::forget(other);
+}
+
 int Character::bab() { return _bab; }
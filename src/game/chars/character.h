@@ -24,6 +24,9 @@
 #include "sector.h"
 #include "weapon.h"
 #include "armor.h"
+#include "combat.h"
+#include "inventory.h"
+#include <list>
 #include <array>
 
 using namespace std;
@@ -45,7 +48,7 @@ class Character : public Entity {
  private:
   int _visionRange;
 
-  Attack* _unarmed;
+  Attack const* _unarmed;
   Armor* _armor{nullptr};
 
   double _speed;
@@ -54,14 +57,31 @@ class Character : public Entity {
 
   Entity* _lastTarget{nullptr};
 
+  Inventory _inventory;
+
+  CombatStats _combatStats;
+  bool _combatStatsValid{false};
+
+  Load _load{Load::light};
+  void updateLoad();
+
  protected:
   array<int, noOfAttributes> _attributes;
 
+  virtual CombatStats computeCombatStats();
+
+  // called whenever items are added to or removed from the inventory
+  void inventoryChanged();
+  // called for every item leaving the inventory, so it isn't kept equipped
+  virtual void unequip(Item* i);
+
+  void dropItems();
+
  public:
   Character(const Tile& t, int hp, int x, int y, double speed, int visionRange,
             const array<int, noOfAttributes>& attributes, World& world,
-            Attack* unarmed, const list<Item*>& inventory = {}, int bab = 0,
-            Size s = Size::medium, int naturalArmor = 0);
+            Attack const* unarmed, const list<Item*>& inventory = {},
+            int bab = 0, Size s = Size::medium, int naturalArmor = 0);
 
   bool los(int x, int y, double factor = 1) const;
   bool los(const Entity& e, double factor = 1) const;
@@ -69,11 +89,21 @@ class Character : public Entity {
 
   bool move(int dx, int dy);
 
+  const Inventory& inventory() const;
+  // returns the stack the item ended up in; merged items are retired
+  Item* addItem(Item* i);
+  bool removeItem(Item* i);
+  double inventoryWeight() const;
+
   virtual void attack(Entity* target);
 
   int armorClass();
 
-  Attack* unarmed();
+  const CombatStats& combatStats();
+  // has to be called whenever anything the combat stats depend on changes
+  void invalidateCombatStats();
+
+  Attack const* unarmed();
 
   Armor* armor() const;
   void setArmor(Armor* armor);
@@ -85,8 +115,6 @@ class Character : public Entity {
   int visionRange() const;
   double speed() const;
 
-  double inventoryWeight();
-
   double lightLoad();
   double mediumLoad();
   double heavyLoad();
@@ -99,6 +127,8 @@ class Character : public Entity {
   Entity* lastTarget() const;
   void setLastTarget(Entity* lastTarget);
 
+  void forget(Entity const* other);
+
   int bab();
 };
 
@@ -18,6 +18,7 @@
 
 #include "companion.h"
 #include "world.h"
+#include <algorithm>
 #include <cstdlib>
 
 using namespace std;
@@ -25,13 +26,15 @@ using namespace std;
 Companion::Companion(const Tile& t, Character* companion, int hp, int x, int y,
                      double speed, int visionRange,
                      const array<int, Character::noOfAttributes>& attributes,
-                     World& world, Attack* unarmed,
+                     World& world, Attack const* unarmed,
                      const list<Item*>& inventory, int bab, Entity::Size s,
                      int naturalArmor)
     : NPC(t, hp, x, y, speed, visionRange, attributes, world, unarmed,
           inventory, bab, s, naturalArmor),
       _companion(companion) {}
 
+Companion::~Companion() { world().pathService().cancel(_ticket); }
+
 void Companion::think() {
   if (lastAttacker() != nullptr) {
     setLastTarget(lastAttacker());
@@ -55,34 +58,30 @@ void Companion::think() {
     _waypointY = _companion->y() + (rand() % 9) - 4;
   }
 
+  // don't bother looking for a way to places that can't be reached
+  if (_waypointX >= 0 && _waypointY >= 0 &&
+      !world().reachable(x(), y(), _waypointX, _waypointY, true)) {
+    _waypointX = -1;
+    _waypointY = -1;
+  }
+
   if (_waypointX >= 0 && _waypointY >= 0) {
     if (World::distance(x(), y(), _waypointX, _waypointY) >
         unarmed()->range()) {
-      auto dir = world().route(x(), y(), _waypointX, _waypointY, true);
-      Command cmd = dir.front();
-
-      int dx = 0;
-      int dy = 0;
-
-      if (cmd == Command::west || cmd == Command::northWest ||
-          cmd == Command::southWest) {
-        dx = -1;
-      } else if (cmd == Command::east || cmd == Command::northEast ||
-                 cmd == Command::southEast) {
-        dx = 1;
-      }
+      // the route is found in the background; until it is there, the old one
+      // or a step straight towards the waypoint has to do
+      updatePlan();
+
+      const int oldX = x();
+      const int oldY = y();
 
-      if (cmd == Command::north || cmd == Command::northWest ||
-          cmd == Command::northEast) {
-        dy = -1;
-      } else if (cmd == Command::south || cmd == Command::southWest ||
-                 cmd == Command::southEast) {
-        dy = 1;
+      if (!followPlan()) {
+        stepTowards(_waypointX, _waypointY);
       }
 
-      move(dx, dy);
-      setLastAction(lastAction() +
-                    (abs(dx) + abs(dy) == 1 ? speed() : 1.5 * speed()));
+      setLastAction(lastAction() + (abs(x() - oldX) + abs(y() - oldY) == 2
+                                        ? 1.5 * speed()
+                                        : speed()));
     } else if (lastTarget() != nullptr && lastTarget()->hp() > 0) {
       attack(lastTarget());
       setLastAction(lastAction() + 2);
@@ -91,3 +90,114 @@ void Companion::think() {
     setLastAction(world().time());
   }
 }
+
+void Companion::forget(Entity const* other) {
+  if (_companion == other) {
+    _companion = nullptr;
+  }
+
+  NPC::forget(other);
+}
+
+void Companion::coarseThink(double elapsed) {
+  if (_companion != nullptr) {
+    _waypointX = _companion->x();
+    _waypointY = _companion->y();
+  }
+
+  if (_waypointX < 0 || _waypointY < 0) {
+    NPC::coarseThink(elapsed);
+    return;
+  }
+
+  // head straight for the waypoint without any path finding
+  const int steps = coarseSteps(elapsed);
+
+  for (int i = 0; i < steps; i++) {
+    if (World::distance(x(), y(), _waypointX, _waypointY) <=
+        unarmed()->range()) {
+      break;  // arrived
+    }
+
+    if (!stepTowards(_waypointX, _waypointY)) {
+      break;  // stuck
+    }
+  }
+}
+
+// picks up requested routes and requests new ones if the waypoint moved
+void Companion::updatePlan() {
+  PathService& paths = world().pathService();
+
+  if (_ticket != PathService::noTicket) {
+    if (auto route = paths.result(_ticket)) {
+      _ticket = PathService::noTicket;
+      _plan.clear();
+      _planStep = 0;
+      _planGoalX = _requestGoalX;
+      _planGoalY = _requestGoalY;
+
+      int px = _requestX;
+      int py = _requestY;
+
+      for (Command cmd : *route) {
+        if (cmd == Command::none) {
+          break;
+        }
+
+        int dx;
+        int dy;
+        offset(cmd, dx, dy);
+
+        px += dx;
+        py += dy;
+        _plan.emplace_back(px, py);
+      }
+    }
+  }
+
+  // the plan is fine as long as it leads close to the waypoint
+  const bool planValid = _planStep < _plan.size() &&
+                         World::distance(_planGoalX, _planGoalY, _waypointX,
+                                         _waypointY) <= 2;
+
+  if (_ticket == PathService::noTicket && !planValid) {
+    _ticket = paths.request(x(), y(), _waypointX, _waypointY, true);
+    _requestX = x();
+    _requestY = y();
+    _requestGoalX = _waypointX;
+    _requestGoalY = _waypointY;
+  }
+}
+
+// takes the next step of the plan; returns false if there is none to take
+bool Companion::followPlan() {
+  // the companion may have strayed onto a later part of the route
+  for (size_t i = _planStep; i < _plan.size(); i++) {
+    if (_plan[i] == make_pair(x(), y())) {
+      _planStep = i + 1;
+    }
+  }
+
+  if (_planStep >= _plan.size()) {
+    return false;
+  }
+
+  const int dx = _plan[_planStep].first - x();
+  const int dy = _plan[_planStep].second - y();
+
+  if (abs(dx) > 1 || abs(dy) > 1 || !move(dx, dy)) {
+    return false;
+  }
+
+  _planStep++;
+  return true;
+}
+
+// moves one step roughly towards the given position
+bool Companion::stepTowards(int tx, int ty) {
+  int dx = (tx > x()) - (tx < x());
+  int dy = (ty > y()) - (ty < y());
+
+  return move(dx, dy) || move(dx, 0) || move(0, dy);
+}
@@ -20,6 +20,9 @@
 #define COMPANION_H
 
 #include "npc.h"
+#include "pathservice.h"
+#include <utility>
+#include <vector>
 
 class Companion : public NPC {
  private:
@@ -28,14 +31,34 @@ class Companion : public NPC {
   int _waypointX{-1};
   int _waypointY{-1};
 
+  // route requested from the path service, but not yet picked up
+  PathService::Ticket _ticket{PathService::noTicket};
+  int _requestX;
+  int _requestY;
+  int _requestGoalX;
+  int _requestGoalY;
+
+  // tiles of the route currently followed, and the next one to enter
+  vector<pair<int, int>> _plan;
+  size_t _planStep{0};
+  int _planGoalX{-1};
+  int _planGoalY{-1};
+
+  void updatePlan();
+  bool followPlan();
+  bool stepTowards(int x, int y);
+
  public:
   Companion(const Tile& t, Character* companion, int hp, int x, int y,
             double speed, int visionRange,
             const array<int, noOfAttributes>& attributes, World& world,
-            Attack* unarmed, const list<Item*>& inventory = {}, int bab = 0,
-            Size s = Size::medium, int naturalArmor = 0);
+            Attack const* unarmed, const list<Item*>& inventory = {},
+            int bab = 0, Size s = Size::medium, int naturalArmor = 0);
+  ~Companion();
 
   void think();
+  void coarseThink(double elapsed);
+  void forget(Entity const* other);
 };
 
 #endif
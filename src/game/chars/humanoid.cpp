@@ -19,123 +19,67 @@
 #include "humanoid.h"
 #include "armor.h"
 #include "world.h"
-#include "attackevent.h"
+#include "weapon.h"
 
 Humanoid::Humanoid(const Tile& t, int hp, int x, int y, double speed,
                    int visionRange,
                    const array<int, noOfAttributes>& attributes, World& world,
-                   Attack* unarmed, const list<Item*>& inventory, int bab,
-                   Size s, int naturalArmor)
+                   Attack const* unarmed, const list<Item*>& inventory,
+                   int bab, Size s, int naturalArmor)
     : Character(t, hp, x, y, speed, visionRange, attributes, world, unarmed,
                 inventory, bab, s, naturalArmor) {}
 
-void Humanoid::attack(Entity* target) {
-  setLastTarget(target);
-  target->setLastAttacker(this);
+CombatStats Humanoid::computeCombatStats() {
+  CombatStats stats = Character::computeCombatStats();
 
-  Weapon* w1 = dynamic_cast<Weapon*>(_mainHand);
-  Weapon* w2 = dynamic_cast<Weapon*>(_offHand);
-
-  int toHitMod = bab() + attributeMod(strength) + size();
-
-  if (w1) {  // weapon in main hand
-    // if character is fighting with two weapons apply a penalty
-    if (_twoWeaponFighting && w2 && w2 != w1) {
-      toHitMod -= 6;
-    }
-
-    int hitRoll = rand() % 20 + 1;
-
-    // natural 20 is a hit, natural 1 a miss
-    if (hitRoll == 20 ||
-        (hitRoll != 1 && hitRoll + toHitMod >= target->armorClass())) {
-      int damageMod = attributeMod(strength);
-
-      if (w1 == w2 && attributeMod(strength) > 0) {  // wielded in both hands
-        damageMod += attributeMod(strength) / 2;
-      }
-
-      int damage = w1->damage() + damageMod;
-
-      bool crit = false;
-
-      if (hitRoll >= w1->critRange()) {  // check if there is a potential crit
-        int res = rand() % 20 + 1 + toHitMod;
-        crit = res >= target->armorClass();
-
-        if (crit) {  // confirm critical hit
-          for (int i = 1; i < w1->critMultiplier(); i++) {
-            damage += w1->damage() + damageMod;
-          }
-        }
-      }
-
-      world().addEvent(std::make_unique<AttackEvent>(*this, *target, true));
-      if (damage <= 0) {
-        damage = 1;
-      }
-
-      target->doDamage(damage);
-    } else {  // miss
-      world().addEvent(std::make_unique<AttackEvent>(*this, *target, false));
-    }
+  if (_mainShield && _mainShield->isShield()) {
+    stats.armorClass += _mainShield->ac();
   }
 
-  if (w2 && w1 != w2 && (!w1 || _twoWeaponFighting)) {
-    toHitMod -= 4;  // off hand has a to hit malus
-    int hitRoll = rand() % 20 + 1;
-
-    if (hitRoll == 20 ||
-        (hitRoll != 1 && hitRoll + toHitMod >= target->armorClass())) {
-      // when fighting with an off hand weapon only half the strength bonus is
-      // applied
-      int damageMod = (attributeMod(strength) > 0)
-                          ? attributeMod(strength) / 2
-                          : attributeMod(strength);  // strength malus
+  if (_offShield && _offShield->isShield() && _offShield != _mainShield) {
+    stats.armorClass += _offShield->ac();
+  }
 
-      int damage = w2->damage() + damageMod;
+  if (!_mainWeapon && !_offWeapon) {  // fight unarmed
+    return stats;
+  }
 
-      bool crit = false;
+  stats.noOfStrikes = 0;
 
-      if (hitRoll >= w2->critRange()) {  // check if there is a potential crit
-        crit = rand() % 20 + 1 + toHitMod >= target->armorClass();
+  const int strMod = attributeMod(strength);
+  int toHitMod = bab() + strMod + size();
 
-        if (crit) {  // confirm critical hit
-          for (int i = 1; i < w2->critMultiplier(); i++) {
-            damage += w2->damage() + damageMod;
-          }
-        }
-      }
+  if (_mainWeapon) {  // weapon in main hand
+    // if character is fighting with two weapons apply a penalty
+    if (_twoWeaponFighting && _offWeapon && _offWeapon != _mainWeapon) {
+      toHitMod -= 6;
+    }
 
-      world().addEvent(std::make_unique<AttackEvent>(*this, *target, true));
+    int damageMod = strMod;
 
-      target->doDamage(damage);
-    } else {
-      world().addEvent(std::make_unique<AttackEvent>(*this, *target, false));
+    if (_mainWeapon == _offWeapon && strMod > 0) {  // wielded in both hands
+      damageMod += strMod / 2;
     }
-  }
 
-  else if (!w1 && !w2) {
-    Character::attack(target);
+    stats.strikes[stats.noOfStrikes++] = {
+        _mainWeapon, toHitMod, damageMod, _mainWeapon->critRange(),
+        _mainWeapon->critMultiplier()};
   }
-}
-
-int Humanoid::armorClass() {
-  int ac = Character::armorClass();
-
-  Armor* s = dynamic_cast<Armor*>(_mainHand);
 
-  if (s && s->isShield()) {
-    ac += s->ac();
-  }
+  if (_offWeapon && _offWeapon != _mainWeapon &&
+      (!_mainWeapon || _twoWeaponFighting)) {
+    toHitMod -= 4;  // off hand has a to hit malus
 
-  Armor* s2 = dynamic_cast<Armor*>(_offHand);
+    // when fighting with an off hand weapon only half the strength bonus is
+    // applied
+    int damageMod = (strMod > 0) ? strMod / 2 : strMod;  // strength malus
 
-  if (s2 && s2->isShield() && s2 != s) {
-    ac += s2->ac();
+    stats.strikes[stats.noOfStrikes++] = {_offWeapon, toHitMod, damageMod,
+                                          _offWeapon->critRange(),
+                                          _offWeapon->critMultiplier()};
   }
 
-  return ac;
+  return stats;
 }
 
 int Humanoid::attributeMod(Character::Attribute attribute) {
@@ -144,8 +88,8 @@ int Humanoid::attributeMod(Character::Attribute attribute) {
   if (attribute == dexterity || attribute == strength) {
     bonus += loadCheckPenalty();
 
-    Armor* s1 = dynamic_cast<Armor*>(_mainHand);
-    Armor* s2 = dynamic_cast<Armor*>(_offHand);
+    Armor* s1 = _mainShield;
+    Armor* s2 = _offShield;
 
     if (attribute == dexterity) {
       if (armor() && bonus > armor()->maxDexBon()) {
@@ -173,17 +117,41 @@ bool Humanoid::twoWeaponFighting() const { return _twoWeaponFighting; }
 
 void Humanoid::setTwoWeaponFighting(bool twoWeaponFighting) {
   _twoWeaponFighting = twoWeaponFighting;
+  invalidateCombatStats();
 }
 
 Item* Humanoid::mainHand() const { return _mainHand; }
 
 Item* Humanoid::offHand() const { return _offHand; }
 
-void Humanoid::setMainHand(Item* i) { _mainHand = i; }
+void Humanoid::setMainHand(Item* i) {
+  _mainHand = i;
+  _mainWeapon = dynamic_cast<Weapon*>(i);
+  _mainShield = dynamic_cast<Armor*>(i);
+  invalidateCombatStats();
+}
 
-void Humanoid::setOffHand(Item* i) { _offHand = i; }
+void Humanoid::setOffHand(Item* i) {
+  _offHand = i;
+  _offWeapon = dynamic_cast<Weapon*>(i);
+  _offShield = dynamic_cast<Armor*>(i);
+  invalidateCombatStats();
+}
 
 void Humanoid::setBothHands(Item* i) {
   setMainHand(i);
   setOffHand(i);
 }
+
+void Humanoid::unequip(Item* i) {
+  // an item may be held in both hands
+  if (_mainHand == i) {
+    setMainHand(nullptr);
+  }
+
+  if (_offHand == i) {
+    setOffHand(nullptr);
+  }
+
+  Character::unequip(i);
+}
@@ -22,22 +22,32 @@
 #include "character.h"
 
 class Item;
+class Weapon;
+class Armor;
 
 class Humanoid : public Character {
  private:
   Item* _mainHand{nullptr};
   Item* _offHand{nullptr};
 
+  // the held items resolved to their actual type when they are equipped
+  Weapon* _mainWeapon{nullptr};
+  Weapon* _offWeapon{nullptr};
+  Armor* _mainShield{nullptr};
+  Armor* _offShield{nullptr};
+
   bool _twoWeaponFighting{false};
 
+ protected:
+  CombatStats computeCombatStats();
+  void unequip(Item* i);
+
  public:
   Humanoid(const Tile& t, int hp, int x, int y, double speed, int visionRange,
            const array<int, noOfAttributes>& attributes, World& world,
-           Attack* unarmed, const list<Item*>& inventory = {}, int bab = 0,
-           Size s = Size::medium, int naturalArmor = 0);
+           Attack const* unarmed, const list<Item*>& inventory = {},
+           int bab = 0, Size s = Size::medium, int naturalArmor = 0);
 
-  void attack(Entity* target);
-  int armorClass();
   int attributeMod(Attribute attribute);
 
   bool twoWeaponFighting() const;
@@ -18,14 +18,38 @@
 
 #include "npc.h"
 #include "character.h"
+#include "world.h"
+#include <cstdlib>
 
 NPC::NPC(const Tile& t, int hp, int x, int y, double speed, int visionRange,
          const array<int, noOfAttributes>& attributes, World& world,
-         Attack* unarmed, const list<Item*>& inventory, int bab, Size s,
-         int naturalArmor)
+         Attack const* unarmed, const list<Item*>& inventory, int bab,
+         Size s, int naturalArmor)
     : Character(t, hp, x, y, speed, visionRange, attributes, world, unarmed,
                 inventory, bab, s, naturalArmor) {}
 
 double NPC::lastAction() const { return _lastAction; }
 
 void NPC::setLastAction(double lastAction) { _lastAction = lastAction; }
+
+int NPC::coarseSteps(double elapsed) {
+  const int steps = static_cast<int>(elapsed / speed());
+
+  if (steps > Sector::size()) {
+    // the rest of the time is lost
+    setLastAction(world().time());
+    return Sector::size();
+  }
+
+  setLastAction(lastAction() + steps * speed());
+  return steps;
+}
+
+void NPC::coarseThink(double elapsed) {
+  // wander about aimlessly, one step for every move the npc could have made
+  const int steps = coarseSteps(elapsed);
+
+  for (int i = 0; i < steps; i++) {
+    move(rand() % 3 - 1, rand() % 3 - 1);
+  }
+}
@@ -26,14 +26,24 @@ class NPC : public Character {
  private:
   double _lastAction{0};
 
+ protected:
+  // the number of moves the npc could have made in the elapsed time, but no
+  // more than the width of a sector. The last action is advanced by the time
+  // they take, so the rest of the time is left for the next call.
+  int coarseSteps(double elapsed);
+
  public:
   NPC(const Tile& t, int hp, int x, int y, double speed, int visionRange,
       const array<int, noOfAttributes>& attributes, World& world,
-      Attack* unarmed, const list<Item*>& inventory = {}, int bab = 0,
+      Attack const* unarmed, const list<Item*>& inventory = {}, int bab = 0,
       Size s = Size::medium, int naturalArmor = 0);
 
   virtual void think() = 0;
 
+  // cheap stand-in for think() used for npcs far away from the player. It
+  // advances the npc by the given amount of time in a single call.
+  virtual void coarseThink(double elapsed);
+
   double lastAction() const;
   void setLastAction(double lastAction);
 };
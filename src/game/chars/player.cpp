@@ -22,13 +22,17 @@
 
 Player::Player(const Tile& t, int hp, int x, int y, double speed,
                int visionRange, array<int, noOfAttributes>& attributes,
-               World& world, Attack* unarmed, const list<Item*>& inventory,
-               int bab, Size s, int naturalArmor)
+               World& world, Attack const* unarmed,
+               const list<Item*>& inventory, int bab, Size s, int naturalArmor)
     : Humanoid(t, hp, x, y, speed, visionRange, attributes, world, unarmed,
                inventory, bab, s, naturalArmor) {}
 
 string Player::itemStatus(Item* i) const {
-  std::string description = i->desc();
+  std::string description = i->desc().to_string();
+
+  if (i->count() > 1) {
+    description += " (" + to_string(i->count()) + ")";
+  }
 
   if (i == mainHand() && i == offHand()) {
     description += " (in both hands)";
@@ -42,3 +46,15 @@ string Player::itemStatus(Item* i) const {
 
   return description;
 }
+
+void Player::explore() {
+  for (int y = this->y() - visionRange(); y <= this->y() + visionRange();
+       y++) {
+    for (int x = this->x() - visionRange(); x <= this->x() + visionRange();
+         x++) {
+      if (world().tile(x, y) != nullptr && los(x, y)) {
+        world().setExplored(x, y);
+      }
+    }
+  }
+}
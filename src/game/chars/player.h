@@ -28,11 +28,14 @@ using namespace std;
 class Player : public Humanoid {
  public:
   Player(const Tile& t, int hp, int x, int y, double speed, int visionRange,
-         array<int, noOfAttributes>& attributes, World& world, Attack* unarmed,
-         const list<Item*>& inventory = {}, int bab = 0, Size s = Size::medium,
-         int naturalArmor = 0);
+         array<int, noOfAttributes>& attributes, World& world,
+         Attack const* unarmed, const list<Item*>& inventory = {}, int bab = 0,
+         Size s = Size::medium, int naturalArmor = 0);
 
   string itemStatus(Item* i) const;
+
+  // marks all tiles the player currently sees as explored
+  void explore();
 };
 
 #endif
@@ -0,0 +1,78 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "combat.h"
+#include "character.h"
+#include "world.h"
+#include "attackevent.h"
+#include <cstdlib>
+
+using namespace std;
+
+void Combat::attack(Character& attacker, Entity& target) {
+  round(attacker, attacker.combatStats(), target, target.armorClass());
+}
+
+void Combat::round(Character& attacker, const CombatStats& stats,
+                   Entity& target, int armorClass) {
+  attacker.setLastTarget(&target);
+  target.setLastAttacker(&attacker);
+
+  const double now = attacker.world().time();
+  attacker.setLastCombat(now);
+  target.setLastCombat(now);
+
+  for (int i = 0; i < stats.noOfStrikes && target.hp() > 0; i++) {
+    strike(attacker, stats.strikes[i], target, armorClass);
+  }
+}
+
+void Combat::strike(Character& attacker, const Strike& s, Entity& target,
+                    int armorClass) {
+  World& world = attacker.world();
+  int hitRoll = rand() % 20 + 1;
+
+  // natural 20 is a hit, natural 1 a miss
+  bool hit = World::distance(attacker.x(), attacker.y(), target.x(),
+                             target.y()) <= s.attack->range() &&
+             (hitRoll == 20 ||
+              (hitRoll != 1 && hitRoll + s.toHit >= armorClass));
+
+  if (!hit) {  // don't do any damage on miss
+    world.addEvent(std::make_unique<AttackEvent>(attacker, target, false));
+    return;
+  }
+
+  int damage = s.attack->damage() + s.damageMod;
+
+  // check if there is a potential crit, then confirm it
+  if (hitRoll >= s.critRange && rand() % 20 + 1 + s.toHit >= armorClass) {
+    for (int i = 1; i < s.critMultiplier; i++) {
+      damage += s.attack->damage() + s.damageMod;
+    }
+  }
+
+  world.addEvent(std::make_unique<AttackEvent>(attacker, target, true));
+
+  if (damage <= 0) {  // hits inflict at least 1 hp damage
+    damage = 1;
+  }
+
+  target.doDamage(damage);
+}
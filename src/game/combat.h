@@ -0,0 +1,61 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef COMBAT_H
+#define COMBAT_H
+
+#include "attack.h"
+#include <array>
+
+using namespace std;
+
+class Character;
+class Entity;
+
+// everything needed to resolve a single swing, precomputed from the
+// attacker's attributes and equipment
+struct Strike {
+  const Attack* attack;
+  int toHit;
+  int damageMod;
+  int critRange;
+  int critMultiplier;
+};
+
+// derived combat values of a character. They are cached by the character and
+// only recomputed after its equipment, attributes or inventory changed.
+struct CombatStats {
+  array<Strike, 2> strikes;  // main hand first, then off hand
+  int noOfStrikes{0};
+  int armorClass{0};
+};
+
+class Combat {
+ public:
+  // resolves a full round of attacks of attacker against target
+  static void attack(Character& attacker, Entity& target);
+
+ private:
+  static void round(Character& attacker, const CombatStats& stats,
+                    Entity& target, int armorClass);
+  static void strike(Character& attacker, const Strike& s, Entity& target,
+                     int armorClass);
+};
+
+#endif
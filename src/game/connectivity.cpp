@@ -0,0 +1,299 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "connectivity.h"
+#include "world.h"
+#include "sector.h"
+#include <algorithm>
+#include <tuple>
+
+Connectivity::Connectivity(World& world)
+    : _world(world),
+      _labels(world.width() * world.height()),
+      _counts(world.width() * world.height(), 0),
+      _dirty(world.width() * world.height(), true),
+      _links(world.width() * world.height()),
+      _base(world.width() * world.height(), 0) {}
+
+void Connectivity::invalidate(int x, int y) {
+  if (_world.sector(x, y) != nullptr) {
+    _dirty[x / Sector::size() + y / Sector::size() * _world.width()] = true;
+    _anyDirty = true;
+  }
+}
+
+bool Connectivity::connected(int x1, int y1, int x2, int y2) {
+  const int r = region(x1, y1);
+  return r >= 0 && r == region(x2, y2);
+}
+
+int Connectivity::region(int x, int y) {
+  if (_world.sector(x, y) == nullptr) {
+    return -1;
+  }
+
+  update();
+
+  const int local = localRegion(x, y);
+
+  if (local < 0) {
+    return -1;
+  }
+
+  const int s = x / Sector::size() + y / Sector::size() * _world.width();
+  return find(_base[s] + local);
+}
+
+void Connectivity::update() {
+  if (!_anyDirty) {
+    return;
+  }
+
+  _anyDirty = false;
+
+  const int w = _world.width();
+  const int h = _world.height();
+
+  // all regions are joined from scratch at first, and whenever they may have
+  // been split up
+  bool rejoin = _parent.empty();
+
+  vector<int> relabeled;
+  vector<bool> relink(_dirty.size(), false);
+
+  for (size_t s = 0; s < _dirty.size(); s++) {
+    if (!_dirty[s]) {
+      continue;
+    }
+
+    if (label(s)) {
+      rejoin = true;
+    }
+
+    _dirty[s] = false;
+    relabeled.push_back(s);
+
+    // the links of the sector itself and of all its neighbours, as their
+    // edges may touch it
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        const int x = s % w + dx;
+        const int y = s / w + dy;
+
+        if (x >= 0 && x < w && y >= 0 && y < h) {
+          relink[x + y * w] = true;
+        }
+      }
+    }
+  }
+
+  for (size_t s = 0; s < relink.size(); s++) {
+    if (relink[s]) {
+      link(s);
+    }
+  }
+
+  int noOfRegions = 0;
+
+  for (int count : _counts) {
+    noOfRegions += count;
+  }
+
+  // the ids of relabeled sectors pile up until the next rejoin
+  if (!rejoin && _parent.size() > 2 * size_t(noOfRegions)) {
+    rejoin = true;
+  }
+
+  if (rejoin) {
+    // the regions of all sectors get consecutive ids
+    int base = 0;
+
+    for (size_t s = 0; s < _base.size(); s++) {
+      _base[s] = base;
+      base += _counts[s];
+    }
+
+    _parent.resize(noOfRegions);
+
+    for (int i = 0; i < noOfRegions; i++) {
+      _parent[i] = i;
+    }
+
+    for (size_t s = 0; s < _links.size(); s++) {
+      uniteLinks(s);
+    }
+  } else {
+    // Nothing has been cut off, so the regions joined before are still
+    // connected. Only the new regions have to be joined with them.
+    for (int s : relabeled) {
+      _base[s] = _parent.size();
+
+      for (int i = 0; i < _counts[s]; i++) {
+        _parent.push_back(_parent.size());
+      }
+    }
+
+    for (size_t s = 0; s < relink.size(); s++) {
+      if (relink[s]) {
+        uniteLinks(s);
+      }
+    }
+  }
+}
+
+void Connectivity::link(int sector) {
+  const int size = Sector::size();
+  const int sx = sector % _world.width();
+  const int sy = sector / _world.width();
+
+  vector<Link>& links = _links[sector];
+  links.clear();
+
+  for (int i = 0; i < size; i++) {
+    // bottom row and right column of the sector
+    const int edge[2][2] = {{sx * size + i, (sy + 1) * size - 1},
+                            {(sx + 1) * size - 1, sy * size + i}};
+
+    for (auto const& tile : edge) {
+      const int local = localRegion(tile[0], tile[1]);
+
+      if (local < 0) {
+        continue;
+      }
+
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+          const int x = tile[0] + dx;
+          const int y = tile[1] + dy;
+
+          if (_world.sector(x, y) != nullptr &&
+              _world.sector(x, y) != _world.sector(tile[0], tile[1])) {
+            const int n = localRegion(x, y);
+
+            if (n >= 0) {
+              links.push_back({local, x / size + y / size * _world.width(), n});
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // neighbouring tiles mostly link the same regions
+  auto key = [](Link const& l) {
+    return make_tuple(l.region, l.sector, l.other);
+  };
+
+  sort(links.begin(), links.end(),
+       [&key](Link const& a, Link const& b) { return key(a) < key(b); });
+  links.erase(unique(links.begin(), links.end(),
+                     [&key](Link const& a, Link const& b) {
+                       return key(a) == key(b);
+                     }),
+              links.end());
+}
+
+void Connectivity::uniteLinks(int sector) {
+  for (Link const& l : _links[sector]) {
+    unite(_base[sector] + l.region, _base[l.sector] + l.other);
+  }
+}
+
+// labels the regions of a sector with a flood fill
+bool Connectivity::label(int sector) {
+  const int size = Sector::size();
+  const int ox = sector % _world.width() * size;
+  const int oy = sector / _world.width() * size;
+
+  vector<int>& labels = _labels[sector];
+  const vector<int> old = move(labels);
+  labels.assign(size * size, -1);
+  _counts[sector] = 0;
+
+  vector<int> open;
+
+  for (int start = 0; start < size * size; start++) {
+    Tile* t = _world.tile(ox + start % size, oy + start / size);
+
+    if (labels[start] >= 0 || t == nullptr || !t->passable()) {
+      continue;
+    }
+
+    const int region = _counts[sector]++;
+    labels[start] = region;
+    open.push_back(start);
+
+    while (!open.empty()) {
+      const int i = open.back();
+      open.pop_back();
+
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+          const int x = i % size + dx;
+          const int y = i / size + dy;
+
+          if (x < 0 || x >= size || y < 0 || y >= size ||
+              labels[x + y * size] >= 0) {
+            continue;
+          }
+
+          Tile* n = _world.tile(ox + x, oy + y);
+
+          if (n != nullptr && n->passable()) {
+            labels[x + y * size] = region;
+            open.push_back(x + y * size);
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < old.size(); i++) {
+    if (old[i] >= 0 && labels[i] < 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int Connectivity::localRegion(int x, int y) const {
+  const int size = Sector::size();
+  return _labels[x / size + y / size * _world.width()]
+                [x % size + y % size * size];
+}
+
+int Connectivity::find(int region) {
+  while (_parent[region] != region) {
+    // path halving
+    _parent[region] = _parent[_parent[region]];
+    region = _parent[region];
+  }
+
+  return region;
+}
+
+void Connectivity::unite(int a, int b) {
+  a = find(a);
+  b = find(b);
+
+  if (a != b) {
+    _parent[max(a, b)] = min(a, b);
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+class World;
+
+/*!
+ * \brief Keeps track of which tiles are connected by passable terrain.
+ *
+ * The passable tiles of every sector are split into regions which are
+ * connected within the sector (moving diagonally, like route() does). The
+ * regions of neighbouring sectors touching each other are joined with a
+ * union-find. Entities are not taken into account, so two tiles in the same
+ * region may still be blocked off from each other by a crowd.
+ *
+ * Changed sectors are relabeled lazily on the next query. Only their own
+ * borders are looked at again. As a union-find can't be split, the regions
+ * are joined anew if a passable tile became impassable; this only goes over
+ * the links between regions remembered for every sector, not over tiles.
+ */
+class Connectivity {
+ public:
+  Connectivity(World& world);
+
+  // has to be called whenever the tile at (x, y) changes
+  void invalidate(int x, int y);
+
+  bool connected(int x1, int y1, int x2, int y2);
+
+  /*!
+   * \return an id shared by all tiles connected to (x, y), or -1 if the tile
+   *	at (x, y) is not passable.
+   */
+  int region(int x, int y);
+
+ private:
+  // two regions touching each other across a sector border
+  struct Link {
+    int region;  // in the sector the link is stored with
+    int sector;  // of the other region
+    int other;
+  };
+
+  void update();
+  // returns true if any tile which was passable before isn't anymore
+  bool label(int sector);
+  // finds the links across the bottom and right edges of a sector
+  void link(int sector);
+  void uniteLinks(int sector);
+  int localRegion(int x, int y) const;
+
+  int find(int region);
+  void unite(int a, int b);
+
+  World& _world;
+
+  // region of each tile within its sector, -1 for impassable tiles
+  vector<vector<int>> _labels;
+  // number of regions in each sector
+  vector<int> _counts;
+  vector<bool> _dirty;
+  bool _anyDirty{true};
+
+  vector<vector<Link>> _links;
+
+  // The global ids of the regions of a sector start at its base. A relabeled
+  // sector gets new ids at the end; the old ones are dropped the next time
+  // all regions are joined anew.
+  vector<int> _base;
+  vector<int> _parent;
+};
+
+#endif
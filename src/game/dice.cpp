@@ -0,0 +1,65 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dice.h"
+#include <sstream>
+
+int Dice::roll() const {
+  int sum = bonus;
+
+  for (int i = 0; i < count && sides > 0; i++) {
+    sum += rand() % sides + 1;
+  }
+
+  return sum;
+}
+
+bool Dice::parse(string const& s, Dice& dice) {
+  istringstream iss(s);
+  int n;
+
+  if (!(iss >> n)) {
+    return false;
+  }
+
+  // a plain number
+  if (iss.peek() == EOF) {
+    dice = {0, 0, n};
+    return true;
+  }
+
+  Dice d = {n, 0, 0};
+  char c;
+
+  if (!(iss >> c) || c != 'd' || !(iss >> d.sides) || d.sides <= 0) {
+    return false;
+  }
+
+  // the sign is read as part of the bonus
+  if (iss.peek() != EOF && !(iss >> d.bonus)) {
+    return false;
+  }
+
+  if (iss.peek() != EOF) {
+    return false;
+  }
+
+  dice = d;
+  return true;
+}
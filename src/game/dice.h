@@ -0,0 +1,44 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DICE_H
+#define DICE_H
+
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+
+// a roll of the form <count>d<sides>+<bonus>, e.g. 2d6+1
+struct Dice {
+  int count;
+  int sides;
+  int bonus;
+
+  int roll() const;
+
+  /*!
+   * \brief Parses dice in the form "2d6+1", "1d4-1", "1d8" or "12".
+   *
+   * \return true if the whole string could be parsed.
+   */
+  static bool parse(string const& s, Dice& dice);
+};
+
+#endif
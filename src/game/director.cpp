@@ -0,0 +1,191 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "director.h"
+#include "world.h"
+#include "sector.h"
+#include "archetypes.h"
+#include "npc.h"
+#include "player.h"
+#include "item.h"
+#include <cstdlib>
+#include <map>
+
+const int Director::_placementTries = 8;
+const double Director::_minPlayerDistance = 16;
+
+Director::Director(World& world, Archetypes const& archetypes)
+    : _world(world),
+      _targets(world.width() * world.height()),
+      _residents(world.width() * world.height()) {
+  for (Archetype const* a : archetypes.all()) {
+    // only monsters are taken care of
+    if (a->density <= 0 || a->kind != Archetype::Kind::monster) {
+      continue;
+    }
+
+    // the fractional part of a density is the chance of an extra monster
+    for (auto& targets : _targets) {
+      int target = int(a->density);
+
+      if (rand() < (a->density - target) * RAND_MAX) {
+        target++;
+      }
+
+      targets[a] = target;
+    }
+  }
+}
+
+map<Archetype const*, int> Director::population(int sx, int sy) const {
+  const int i = sx + sy * _world.width();
+  map<Archetype const*, int> counts;
+
+  for (Resident const& r : _residents[i]) {
+    counts[r.archetype]++;
+  }
+
+  // monsters may have wandered in while the sector was asleep
+  Sector const* s = _world.sector(sx * Sector::size(), sy * Sector::size());
+
+  for (Entity const* e : s->entities()) {
+    auto spawned = _spawned.find(e);
+
+    if (spawned != _spawned.end() && e->hp() > 0) {
+      counts[spawned->second]++;
+    }
+  }
+
+  return counts;
+}
+
+void Director::wake(int sx, int sy) {
+  const int i = sx + sy * _world.width();
+  vector<Resident>& residents = _residents[i];
+
+  // replace the monsters killed since the sector was last awake
+  map<Archetype const*, int> counts = population(sx, sy);
+
+  for (auto const& target : _targets[i]) {
+    for (int n = counts[target.first]; n < target.second; n++) {
+      residents.push_back({target.first, -1, -1, 0, 0});
+    }
+  }
+
+  vector<Resident> unplaced;
+
+  for (Resident& r : residents) {
+    if (!place(sx, sy, r)) {
+      // maybe there is some room the next time
+      unplaced.push_back(r);
+      continue;
+    }
+
+    Entity* e = _world.spawn(*r.archetype, r.x, r.y);
+
+    if (r.hp > 0) {
+      e->setHp(r.hp);
+    }
+
+    // monsters which have been here before catch up on the time they were
+    // asleep, new ones start out fresh
+    if (NPC* n = dynamic_cast<NPC*>(e)) {
+      n->setLastAction(r.lastAction > 0 ? r.lastAction : _world.time());
+    }
+
+    _spawned[e] = r.archetype;
+  }
+
+  residents = move(unplaced);
+}
+
+void Director::sleep(int sx, int sy) {
+  const int i = sx + sy * _world.width();
+  Sector* s = _world.sector(sx * Sector::size(), sy * Sector::size());
+  vector<Resident>& residents = _residents[i];
+
+  map<Archetype const*, int> counts;
+
+  for (Resident const& r : residents) {
+    counts[r.archetype]++;
+  }
+
+  // entities are removed from the sector while iterating
+  vector<Entity*> ents(s->entities().begin(), s->entities().end());
+
+  for (Entity* e : ents) {
+    auto spawned = _spawned.find(e);
+
+    if (spawned == _spawned.end() || e->hp() <= 0) {
+      continue;
+    }
+
+    Archetype const* a = spawned->second;
+    _spawned.erase(spawned);
+
+    // Monsters beyond the sector's target have wandered in from elsewhere;
+    // they move on and are gone. Otherwise the population would grow with
+    // every monster crossing a sector border.
+    NPC* n = static_cast<NPC*>(e);
+
+    if (counts[a] < _targets[i][a]) {
+      residents.push_back({a, e->x(), e->y(), e->hp(),
+                           n->lastAction()});
+      counts[a]++;
+    }
+
+    // the inventory is recreated from the archetype
+    vector<Item*> items(n->inventory().begin(), n->inventory().end());
+
+    for (Item* i : items) {
+      n->removeItem(i);
+      _world.retire(i);
+    }
+
+    _world.removeEntity(e);
+    _world.retire(e);
+  }
+}
+
+void Director::forget(Entity const* e) { _spawned.erase(e); }
+
+bool Director::place(int sx, int sy, Resident& r) const {
+  Player const* player = _world.player();
+
+  // monsters which have been put to sleep are where they were left,
+  // unless someone else has taken their place
+  if (r.x >= 0 && _world.passable(r.x, r.y)) {
+    return true;
+  }
+
+  for (int i = 0; i < _placementTries; i++) {
+    const int x = sx * Sector::size() + rand() % Sector::size();
+    const int y = sy * Sector::size() + rand() % Sector::size();
+
+    if (_world.passable(x, y) &&
+        World::distance(x, y, player->x(), player->y()) >=
+            _minPlayerDistance) {
+      r.x = x;
+      r.y = y;
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,87 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DIRECTOR_H
+#define DIRECTOR_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+class World;
+class Entity;
+class Archetypes;
+struct Archetype;
+
+/*!
+ * \brief Keeps the world populated with monsters.
+ *
+ * Every sector has a population made up of the archetypes with a density,
+ * i.e. the number of them per sector. While a sector is asleep, its
+ * population is only a list of residents, which costs nothing to simulate.
+ * Once the sector wakes up, the residents are spawned, and the population is
+ * topped up to make up for monsters killed in the meantime. When the sector
+ * falls asleep again, the monsters spawned by the director are turned back
+ * into residents.
+ */
+class Director {
+ public:
+  Director(World& world, Archetypes const& archetypes);
+
+  // have to be called when the sector at (sx, sy) changes its activity
+  void wake(int sx, int sy);
+  void sleep(int sx, int sy);
+
+  // has to be called before an entity is deleted
+  void forget(Entity const* e);
+
+ private:
+  // a monster waiting for its sector to wake up
+  struct Resident {
+    Archetype const* archetype;
+
+    // -1 if it hasn't been placed yet
+    int x;
+    int y;
+    int hp;
+    double lastAction;
+  };
+
+  bool place(int sx, int sy, Resident& r) const;
+  // residents and living monsters in a sector, by archetype
+  map<Archetype const*, int> population(int sx, int sy) const;
+
+  World& _world;
+
+  // how many monsters of each archetype a sector should have
+  vector<map<Archetype const*, int>> _targets;
+  vector<vector<Resident>> _residents;
+
+  // all monsters spawned by the director, by the archetype they came from
+  unordered_map<Entity const*, Archetype const*> _spawned;
+
+  // how often to try finding a free tile for a new monster
+  static const int _placementTries;
+  // how close to the player monsters may appear out of nothing
+  static const double _minPlayerDistance;
+};
+
+#endif
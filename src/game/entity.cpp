@@ -19,9 +19,9 @@
 #include "entity.h"
 #include "world.h"
 #include "sector.h"
-#include "item.h"
+#include "character.h"
 #include "deathevent.h"
-#include "dropevent.h"
+#include <limits>
 
 Character* Entity::lastAttacker() const { return _lastAttacker; }
 
@@ -29,11 +29,21 @@ void Entity::setLastAttacker(Character* lastAttacker) {
   _lastAttacker = lastAttacker;
 }
 
+double Entity::lastCombat() const { return _lastCombat; }
+
+void Entity::setLastCombat(double time) { _lastCombat = time; }
+
+void Entity::forget(Entity const* other) {
+  if (_lastAttacker == other) {
+    _lastAttacker = nullptr;
+  }
+}
+
 int Entity::maxHp() const { return _maxHp; }
 
 void Entity::setMaxHp(int maxHp) { _maxHp = maxHp; }
 Entity::Entity(const Tile& t, int hp, int x, int y, World& world, Size s,
-               int naturalArmor, const list<Item*>& inventory)
+               int naturalArmor)
     : _t(t),
       _x(x),
       _y(y),
@@ -42,23 +52,18 @@ Entity::Entity(const Tile& t, int hp, int x, int y, World& world, Size s,
       _naturalArmor(naturalArmor),
       _s(s),
       _world(world),
-      _inventory(inventory) {
-  _sector = world.sector(x, y);
-
-  if (_sector) {
-    _sector->addEntity(this);
-  }
+      _sector(nullptr),
+      _lastCombat(-numeric_limits<double>::infinity()) {
+  setSector(world.sector(x, y));
 }
 
-Entity::~Entity() {
-  if (_sector) {
-    _sector->removeEntity(this);
-  }
-}
+Entity::~Entity() { setSector(nullptr); }
 
 int Entity::armorClass() { return 5 + _s + _naturalArmor; }
 
-string Entity::dieMessage() { return "The " + desc() + " is destroyed."; }
+string Entity::dieMessage() {
+  return "The " + desc().to_string() + " is destroyed.";
+}
 
 const Tile& Entity::t() const { return _t; }
 
@@ -76,9 +81,9 @@ int Entity::lastKnownX() const { return _lastKnownX; }
 
 int Entity::lastKnownY() const { return _lastKnownY; }
 
-string Entity::prefix() const { return _t.prefix(); }
+boost::string_view Entity::prefix() const { return _t.prefix(); }
 
-string Entity::desc() const { return _t.desc(); }
+boost::string_view Entity::desc() const { return _t.desc(); }
 
 int Entity::hp() const { return _hp; }
 
@@ -86,24 +91,33 @@ Entity::Size Entity::size() const { return _s; }
 
 int Entity::naturalArmor() const { return _naturalArmor; }
 
-list<Item*>& Entity::inventory() { return _inventory; }
+void Entity::dropItems() {}
 
 void Entity::setXY(int x, int y) {
+  // the spatial index has to be updated with the old coordinates
+  setSector(nullptr);
+
+  setPosition(x, y);
+  setSector(_world.sector(_x, _y));
+}
+
+void Entity::setPosition(int x, int y) {
   _x = x;
   _y = y;
-  setSector(_world.sector(_x, _y));
 }
 
 void Entity::setSector(Sector* sector) {
   if (_sector != nullptr) {
     _sector->removeEntity(this);
-  }
-
-  if (sector != nullptr) {
-    sector->addEntity(this);
+    _world.spatialIndex().remove(this);
   }
 
   _sector = sector;
+
+  if (_sector != nullptr) {
+    _sector->addEntity(this);
+    _world.spatialIndex().insert(this);
+  }
 }
 
 void Entity::setSeen(bool seen) { _seen = seen; }
@@ -113,17 +127,17 @@ void Entity::setLastKnownX() { _lastKnownX = _x; }
 void Entity::setLastKnownY() { _lastKnownY = _y; }
 
 void Entity::setHp(int hp) {
-  if (hp <= 0) {
-    world().addEvent(std::make_unique<DeathEvent>(*this));
+  if (_sector != nullptr) {
+    _sector->markChanged();
+  }
 
-    // drop inventory
-    for (Item* e : _inventory) {
-      e->setXY(_x, _y);
-      e->setSeen(false);
-      world().addEvent(std::make_unique<DropEvent>(*this, *e));
-    }
+  // the dead can't die again
+  if (hp <= 0 && _hp > 0) {
+    world().addEvent(std::make_unique<DeathEvent>(*this));
 
-    _sector->removeEntity(this);
+    dropItems();
+    setSector(nullptr);
+    world().retire(this);
   }
 
   _hp = hp;
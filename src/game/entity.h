@@ -20,7 +20,8 @@
 #define ENTITY_H
 
 #include "tile.h"
-#include <list>
+#include <boost/utility/string_view.hpp>
+#include <string>
 
 class Item;
 class World;
@@ -64,14 +65,18 @@ class Entity {
   int _lastKnownX;
   int _lastKnownY;
 
-  list<Item*> _inventory;
-
   Character* _lastAttacker{nullptr};
 
+  // time of the last attack made by or against the entity
+  double _lastCombat;
+
+ protected:
+  // called by setHp when the entity dies, e.g. to drop what it carries
+  virtual void dropItems();
+
  public:
   Entity(const Tile& t, int hp, int x, int y, World& world,
-         Size s = Size::medium, int naturalArmor = 0,
-         const list<Item*>& inventory = {});
+         Size s = Size::medium, int naturalArmor = 0);
   virtual ~Entity();
 
   virtual string dieMessage();
@@ -87,8 +92,8 @@ class Entity {
   int lastKnownX() const;
   int lastKnownY() const;
 
-  string prefix() const;
-  string desc() const;
+  boost::string_view prefix() const;
+  boost::string_view desc() const;
 
   int maxHp() const;
   Character* lastAttacker() const;
@@ -98,11 +103,11 @@ class Entity {
   int naturalArmor() const;
   virtual int armorClass();
 
-  list<Item*>& inventory();
-
   void setX(int x);
   void setY(int y);
   void setXY(int x, int y);
+  // moves the entity without putting it into a sector
+  void setPosition(int x, int y);
   void setSector(Sector* Sector);
 
   void setSeen(bool seen = true);
@@ -113,6 +118,12 @@ class Entity {
   void doDamage(int dmg);
 
   void setLastAttacker(Character* lastAttacker);
+
+  double lastCombat() const;
+  void setLastCombat(double time);
+
+  // drops all references to an entity which is about to be deleted
+  virtual void forget(Entity const* other);
   void setMaxHp(int maxHp);
 };
 #endif
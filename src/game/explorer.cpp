@@ -0,0 +1,133 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "explorer.h"
+#include "world.h"
+#include <cstdlib>
+#include <queue>
+
+const int Explorer::_range = 64;
+
+Explorer::Explorer(World& world) : _world(world) {}
+
+Command Explorer::next(int x, int y) {
+  _blocked = false;
+
+  // already standing on the next position
+  if (!_path.empty() && _path.back() == make_pair(x, y)) {
+    _path.pop_back();
+  }
+
+  // Stick to the old path as long as it leads to a frontier, the character
+  // hasn't strayed from it and nothing stands in the way. Otherwise the
+  // character would bump into e.g. its companion over and over again.
+  if (_path.empty() || !frontier(_path.front().first, _path.front().second) ||
+      abs(_path.back().first - x) > 1 || abs(_path.back().second - y) > 1 ||
+      !_world.passable(_path.back().first, _path.back().second)) {
+    if (!search(x, y, true)) {
+      // there may be frontiers which are only out of reach for now
+      _blocked = search(x, y, false);
+      _path.clear();
+
+      return Command::none;
+    }
+  }
+
+  pair<int, int> const step = _path.back();
+  _path.pop_back();
+
+  return direction(step.first - x, step.second - y);
+}
+
+bool Explorer::blocked() const { return _blocked; }
+
+bool Explorer::frontier(int x, int y) const {
+  Tile* t = _world.tile(x, y);
+
+  if (t == nullptr || !t->passable() || !_world.explored(x, y)) {
+    return false;
+  }
+
+  for (int dy = -1; dy <= 1; dy++) {
+    for (int dx = -1; dx <= 1; dx++) {
+      if (_world.tile(x + dx, y + dy) != nullptr &&
+          !_world.explored(x + dx, y + dy)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool Explorer::search(int x, int y, bool avoid) {
+  _path.clear();
+
+  // the search is confined to a square around the start
+  const int size = 2 * _range + 1;
+  const int none = -1;
+
+  // index of the tile each tile was reached from
+  vector<int> parent(size * size, none);
+  queue<int> open;
+
+  const int start = _range + _range * size;
+  parent[start] = start;
+  open.push(start);
+
+  while (!open.empty()) {
+    const int i = open.front();
+    open.pop();
+
+    const int tx = x + i % size - _range;
+    const int ty = y + i / size - _range;
+
+    if (i != start && frontier(tx, ty)) {
+      // walk back to the start, which is left out of the path
+      for (int j = i; j != start; j = parent[j]) {
+        _path.emplace_back(x + j % size - _range, y + j / size - _range);
+      }
+
+      return true;
+    }
+
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        const int nx = i % size + dx;
+        const int ny = i / size + dy;
+
+        if (nx < 0 || nx >= size || ny < 0 || ny >= size) {
+          continue;
+        }
+
+        const int n = nx + ny * size;
+        Tile* t = _world.tile(tx + dx, ty + dy);
+
+        if (parent[n] == none && t != nullptr && t->passable() &&
+            _world.explored(tx + dx, ty + dy) &&
+            (!avoid || i != start || _world.passable(tx + dx, ty + dy))) {
+          parent[n] = i;
+          open.push(n);
+        }
+      }
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,69 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EXPLORER_H
+#define EXPLORER_H
+
+#include "command.h"
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class World;
+
+/*!
+ * \brief Guides a character to the unexplored parts of the world.
+ *
+ * The nearest frontier, i.e. an explored passable tile next to an unexplored
+ * one, is found with a breadth first search over the explored tiles. The path
+ * to it is kept and followed until the target stops being a frontier, so
+ * most steps do not search at all.
+ */
+class Explorer {
+ public:
+  Explorer(World& world);
+
+  /*!
+   * \return the next step from (x, y) towards the nearest frontier, or
+   *	Command::none if there is no frontier in range.
+   */
+  Command next(int x, int y);
+
+  // true if the last call to next() found no step only because something is
+  // standing in the way
+  bool blocked() const;
+
+ private:
+  bool frontier(int x, int y) const;
+  // if avoid is true, the first step must not be blocked by an entity
+  bool search(int x, int y, bool avoid);
+
+  World& _world;
+
+  // remaining positions up to the current target, the next one at the back
+  vector<pair<int, int>> _path;
+
+  bool _blocked{false};
+
+  // how far away from the start the search looks for a frontier
+  static const int _range;
+};
+
+#endif
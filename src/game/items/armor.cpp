@@ -17,14 +17,14 @@
  */
 
 #include "armor.h"
+#include "archetypes.h"
 
-Armor::Armor(Tile& t, int ac, int maxDexBon, int checkPenalty, bool shield,
-             double weight, World& world, int x, int y, Size s)
-    : Item(t, weight, world, ac * 5, x, y, s),
-      _ac(ac),
-      _maxDexBon(maxDexBon),
-      _checkPenalty(checkPenalty),
-      _shield(shield) {}
+Armor::Armor(Archetype const& archetype, World& world, int hp)
+    : Item(archetype, world, hp),
+      _ac(archetype.ac),
+      _maxDexBon(archetype.maxDexBon),
+      _checkPenalty(archetype.checkPenalty),
+      _shield(archetype.shield) {}
 
 int Armor::ac() const { return _ac; }
 
@@ -33,3 +33,9 @@ int Armor::maxDexBon() const { return _maxDexBon; }
 int Armor::checkPenalty() const { return _checkPenalty; }
 
 bool Armor::isShield() const { return _shield; }
+
+bool Armor::stackable() const { return false; }
+
+Inventory::Category Armor::category() const {
+  return Inventory::Category::armor;
+}
@@ -30,14 +30,14 @@ class Armor : public Item {
   bool _shield;
 
  public:
-  Armor(Tile& t, int ac, int maxDexBon, int checkPenalty, bool shield,
-        double weight, World& world, int x = -1, int y = -1,
-        Size s = Size::small);
+  Armor(Archetype const& archetype, World& world, int hp);
 
   int ac() const;
   int maxDexBon() const;
   int checkPenalty() const;
   bool isShield() const;
+  bool stackable() const;
+  Inventory::Category category() const;
 };
 
 #endif
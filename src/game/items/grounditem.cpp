@@ -0,0 +1,28 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "grounditem.h"
+#include "archetypes.h"
+
+Tile const& GroundItem::tile() const { return archetype->tile; }
+
+bool GroundItem::stacksWith(GroundItem const& other) const {
+  // like Item::stacksWith; gear can't be stacked
+  return archetype == other.archetype &&
+         archetype->kind == Archetype::Kind::item && hp == other.hp;
+}
@@ -0,0 +1,42 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GROUNDITEM_H
+#define GROUNDITEM_H
+
+#include "tile.h"
+
+struct Archetype;
+
+/*!
+ * \brief A stack of items lying on the ground.
+ *
+ * Only a few bytes are kept for every stack on the ground, so piles of loot
+ * are cheap. The full Item is made once the stack is picked up.
+ */
+struct GroundItem {
+  Archetype const* archetype;
+  int count;
+  int hp;
+  bool seen;  // by the player
+
+  Tile const& tile() const;
+  bool stacksWith(GroundItem const& other) const;
+};
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "inventory.h"
+#include "item.h"
+#include <algorithm>
+
+using namespace std;
+
+const Inventory::Slot Inventory::npos = static_cast<Inventory::Slot>(-1);
+
+Inventory::Inventory(const list<Item*>& items) {
+  for (Item* i : items) {
+    add(i);
+  }
+}
+
+Inventory::Slot Inventory::add(Item* i) {
+  Slot s;
+
+  if (!_free.empty()) {
+    s = _free.back();
+    _free.pop_back();
+    _slots[s] = i;
+  } else {
+    s = _slots.size();
+    _slots.push_back(i);
+  }
+
+  _size++;
+  _lookup[i] = s;
+  _weight += i->weight();
+
+  vector<Slot>& cat = _categories[static_cast<size_t>(i->category())];
+  cat.insert(upper_bound(cat.begin(), cat.end(), s), s);
+
+  pair<boost::string_view, Slot> desc(i->desc(), s);
+  _descriptions.insert(
+      upper_bound(_descriptions.begin(), _descriptions.end(), desc), desc);
+
+  return s;
+}
+
+bool Inventory::remove(Item* i) {
+  auto it = _lookup.find(i);
+
+  if (it == _lookup.end()) {
+    return false;
+  }
+
+  Slot s = it->second;
+  _lookup.erase(it);
+
+  _slots[s] = nullptr;
+  _free.push_back(s);
+  _size--;
+  _weight -= i->weight();
+
+  vector<Slot>& cat = _categories[static_cast<size_t>(i->category())];
+  cat.erase(lower_bound(cat.begin(), cat.end(), s));
+
+  pair<boost::string_view, Slot> desc(i->desc(), s);
+  _descriptions.erase(
+      lower_bound(_descriptions.begin(), _descriptions.end(), desc));
+
+  return true;
+}
+
+Item* Inventory::stackFor(const Item* i) const {
+  // like items share their description
+  for (auto it = lower_bound(_descriptions.begin(), _descriptions.end(),
+                             make_pair(i->desc(), Slot(0)));
+       it != _descriptions.end() && it->first == i->desc(); ++it) {
+    Item* stack = _slots[it->second];
+
+    if (stack != i && stack->stacksWith(i)) {
+      return stack;
+    }
+  }
+
+  return nullptr;
+}
+
+void Inventory::grow(Item* stack, int count) {
+  _weight -= stack->weight();
+  stack->setCount(stack->count() + count);
+  _weight += stack->weight();
+}
+
+void Inventory::clear() { *this = Inventory(); }
+
+bool Inventory::contains(const Item* i) const {
+  return _lookup.find(i) != _lookup.end();
+}
+
+Inventory::Slot Inventory::slot(const Item* i) const {
+  auto it = _lookup.find(i);
+  return it != _lookup.end() ? it->second : npos;
+}
+
+Item* Inventory::at(Slot s) const {
+  return s < _slots.size() ? _slots[s] : nullptr;
+}
+
+size_t Inventory::size() const { return _size; }
+
+bool Inventory::empty() const { return _size == 0; }
+
+double Inventory::weight() const { return _weight; }
+
+Inventory::const_iterator Inventory::begin() const {
+  return const_iterator(_slots.begin(), _slots.end());
+}
+
+Inventory::const_iterator Inventory::end() const {
+  return const_iterator(_slots.end(), _slots.end());
+}
+
+const vector<Inventory::Slot>& Inventory::slots(Category c) const {
+  return _categories[static_cast<size_t>(c)];
+}
+
+vector<Item*> Inventory::withPrefix(boost::string_view prefix) const {
+  vector<Item*> items;
+
+  // all matching descriptions are stored consecutively, starting with the
+  // first one not smaller than the prefix itself
+  for (auto it = lower_bound(_descriptions.begin(), _descriptions.end(),
+                             make_pair(prefix, Slot(0)));
+       it != _descriptions.end() && it->first.starts_with(prefix);
+       ++it) {
+    items.push_back(_slots[it->second]);
+  }
+
+  return items;
+}
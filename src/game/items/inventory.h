@@ -0,0 +1,142 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include <boost/utility/string_view.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class Item;
+
+// Contiguous item storage. Every item keeps the slot it was added to until it
+// is removed again; freed slots are reused by later items.
+class Inventory {
+ public:
+  typedef size_t Slot;
+  static const Slot npos;
+
+  // inventories are partitioned by the kind of items they hold
+  enum class Category { weapon, armor, other, noOfCategories };
+
+  // iterates over all items in slot order, skipping free slots
+  class const_iterator {
+   public:
+    typedef forward_iterator_tag iterator_category;
+    typedef Item* value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Item* const* pointer;
+    typedef Item* const& reference;
+
+    const_iterator(vector<Item*>::const_iterator pos,
+                   vector<Item*>::const_iterator end)
+        : _pos(pos), _end(end) {
+      skip();
+    }
+
+    reference operator*() const { return *_pos; }
+
+    const_iterator& operator++() {
+      ++_pos;
+      skip();
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return _pos == other._pos;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return _pos != other._pos;
+    }
+
+   private:
+    void skip() {
+      while (_pos != _end && *_pos == nullptr) {
+        ++_pos;
+      }
+    }
+
+    vector<Item*>::const_iterator _pos;
+    vector<Item*>::const_iterator _end;
+  };
+
+ private:
+  vector<Item*> _slots;  // nullptr marks a free slot
+  vector<Slot> _free;
+  size_t _size{0};
+
+  unordered_map<const Item*, Slot> _lookup;
+
+  // slots of the items of each category, in ascending order
+  array<vector<Slot>, static_cast<size_t>(Category::noOfCategories)>
+      _categories;
+
+  // (description, slot) pairs sorted by description for prefix searches. The
+  // descriptions are interned, so they don't have to be copied.
+  vector<pair<boost::string_view, Slot>> _descriptions;
+
+  double _weight{0};
+
+ public:
+  Inventory(const list<Item*>& items = {});
+
+  Slot add(Item* i);
+  bool remove(Item* i);
+
+  // returns an item the given one could be stacked onto, if there is any
+  Item* stackFor(const Item* i) const;
+  // adds count items to a stack in the inventory
+  void grow(Item* stack, int count);
+  void clear();
+
+  bool contains(const Item* i) const;
+  Slot slot(const Item* i) const;
+  Item* at(Slot s) const;
+
+  size_t size() const;
+  bool empty() const;
+  double weight() const;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  const vector<Slot>& slots(Category c) const;
+
+  // returns the items whose description starts with prefix, sorted by their
+  // description
+  vector<Item*> withPrefix(boost::string_view prefix) const;
+};
+
+#endif
@@ -17,9 +17,27 @@
  */
 
 #include "item.h"
+#include "archetypes.h"
 
-Item::Item(const Tile& t, double weight, World& world, int hp, int x, int y,
-           Size s)
-    : Entity(t, hp, x, y, world, s), _weight(weight) {}
+Item::Item(Archetype const& archetype, World& world, int hp)
+    : Entity(archetype.tile, hp, -1, -1, world, archetype.size),
+      _archetype(archetype) {}
 
-double Item::weight() const { return _weight; }
+Archetype const& Item::archetype() const { return _archetype; }
+
+double Item::weight() const { return _archetype.weight * _count; }
+
+int Item::count() const { return _count; }
+
+void Item::setCount(int count) { _count = count; }
+
+bool Item::stackable() const { return true; }
+
+bool Item::stacksWith(Item const* other) const {
+  return stackable() && other->stackable() &&
+         &_archetype == &other->_archetype && hp() == other->hp();
+}
+
+Inventory::Category Item::category() const {
+  return Inventory::Category::other;
+}
@@ -20,16 +20,35 @@
 #define ITEM_H
 
 #include "entity.h"
+#include "inventory.h"
 
+struct Archetype;
+
+// Items are created off the map. Use World::putItem to put them on the ground.
 class Item : public Entity {
  private:
-  double _weight;
+  Archetype const& _archetype;
+
+  // number of items in the stack
+  int _count{1};
 
  public:
-  Item(const Tile& t, double weight, World& world, int hp, int x = -1,
-       int y = -1, Size s = Size::medium);
+  Item(Archetype const& archetype, World& world, int hp);
+
+  Archetype const& archetype() const;
 
+  // weight of the whole stack
   double weight() const;
+
+  int count() const;
+  // items in an inventory have to be changed with Inventory::grow instead
+  void setCount(int count);
+
+  // items with some kind of individual state (e.g. gear) can't be stacked
+  virtual bool stackable() const;
+  bool stacksWith(Item const* other) const;
+
+  virtual Inventory::Category category() const;
 };
 
 #endif
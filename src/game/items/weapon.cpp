@@ -17,9 +17,17 @@
  */
 
 #include "weapon.h"
+#include "archetypes.h"
 
-Weapon::Weapon(const Tile& t, Attack a, bool twoHanded, double weight,
-               World& world, int hp, int x, int y, Size s)
-    : Item(t, weight, world, hp, x, y, s), Attack(a), _twoHanded(twoHanded) {}
+Weapon::Weapon(Archetype const& archetype, World& world, int hp)
+    : Item(archetype, world, hp),
+      Attack(archetype.attack),
+      _twoHanded(archetype.twoHanded) {}
 
 bool Weapon::twoHanded() { return _twoHanded; }
+
+bool Weapon::stackable() const { return false; }
+
+Inventory::Category Weapon::category() const {
+  return Inventory::Category::weapon;
+}
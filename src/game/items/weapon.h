@@ -27,10 +27,11 @@ class Weapon : public Item, public Attack {
   bool _twoHanded;
 
  public:
-  Weapon(const Tile& t, Attack a, bool twoHanded, double weight, World& world,
-         int hp, int x = -1, int y = -1, Size s = Size::small);
+  Weapon(Archetype const& archetype, World& world, int hp);
 
   bool twoHanded();
+  bool stackable() const;
+  Inventory::Category category() const;
 };
 
 #endif
@@ -0,0 +1,269 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef JUMPPOINT_H
+#define JUMPPOINT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Jump point search (Harabor and Grastien, 2011) on an 8-connected grid where
+// diagonal moves may cut corners, like in World::route(). Straight steps cost
+// 2, diagonal ones 3.
+//
+// Instead of expanding every neighbour, the search jumps along straight and
+// diagonal lines and only stops at tiles where an obstacle could make a
+// detour necessary. On open terrain this expands only a handful of nodes.
+template <typename Passable>
+class JumpPointSearch {
+ public:
+  // passable(x, y) has to return whether the tile at (x, y) can be entered
+  JumpPointSearch(Passable passable) : _passable(passable) {}
+
+  /*!
+   * \return every tile on the way from (x1, y1) to (x2, y2), excluding the
+   *	start, or an empty vector if there is no path.
+   */
+  vector<pair<int, int>> path(int x1, int y1, int x2, int y2);
+
+  // number of nodes expanded by the last search
+  size_t expansions() const { return _expansions; }
+
+ private:
+  struct Node {
+    int g;
+    int parentX;
+    int parentY;
+    bool closed;
+  };
+
+  struct Open {
+    int f;
+    int g;
+    int x;
+    int y;
+
+    bool operator<(Open const& rhs) const { return f > rhs.f; }
+  };
+
+  static int64_t key(int x, int y) {
+    return (int64_t(x) << 32) | uint32_t(y);
+  }
+
+  static int cost(int x1, int y1, int x2, int y2) {
+    const int dx = abs(x2 - x1);
+    const int dy = abs(y2 - y1);
+    return min(dx, dy) + 2 * max(dx, dy);
+  }
+
+  bool passable(int x, int y) { return _passable(x, y); }
+  bool jump(int& x, int& y, int dx, int dy);
+
+  Passable _passable;
+
+  int _goalX;
+  int _goalY;
+
+  size_t _expansions{0};
+};
+
+template <typename Passable>
+vector<pair<int, int>> JumpPointSearch<Passable>::path(int x1, int y1, int x2,
+                                                       int y2) {
+  _goalX = x2;
+  _goalY = y2;
+  _expansions = 0;
+
+  unordered_map<int64_t, Node> nodes;
+  priority_queue<Open> open;
+
+  nodes[key(x1, y1)] = {0, x1, y1, false};
+  open.push({cost(x1, y1, x2, y2), 0, x1, y1});
+
+  while (!open.empty()) {
+    const Open current = open.top();
+    open.pop();
+
+    Node& node = nodes[key(current.x, current.y)];
+
+    if (node.closed || current.g > node.g) {
+      continue;  // outdated entry
+    }
+
+    node.closed = true;
+
+    if (current.x == x2 && current.y == y2) {
+      // walk back along the jump points, filling in the tiles in between
+      vector<pair<int, int>> tiles;
+
+      for (int x = x2, y = y2; x != x1 || y != y1;) {
+        Node const& n = nodes[key(x, y)];
+        const int dx = (n.parentX > x) - (n.parentX < x);
+        const int dy = (n.parentY > y) - (n.parentY < y);
+
+        for (; x != n.parentX || y != n.parentY; x += dx, y += dy) {
+          tiles.emplace_back(x, y);
+        }
+      }
+
+      reverse(tiles.begin(), tiles.end());
+      return tiles;
+    }
+
+    _expansions++;
+
+    // direction the node was reached from; none for the start
+    const int px = node.parentX;
+    const int py = node.parentY;
+    const int dx = (current.x > px) - (current.x < px);
+    const int dy = (current.y > py) - (current.y < py);
+
+    const int x = current.x;
+    const int y = current.y;
+
+    // the directions worth following from here (pruned neighbours)
+    vector<pair<int, int>> directions;
+
+    if (dx == 0 && dy == 0) {
+      for (int i = -1; i <= 1; i++) {
+        for (int j = -1; j <= 1; j++) {
+          if (i != 0 || j != 0) {
+            directions.emplace_back(i, j);
+          }
+        }
+      }
+    } else if (dx != 0 && dy != 0) {
+      directions = {{dx, 0}, {0, dy}, {dx, dy}};
+
+      if (!passable(x - dx, y)) {
+        directions.emplace_back(-dx, dy);
+      }
+
+      if (!passable(x, y - dy)) {
+        directions.emplace_back(dx, -dy);
+      }
+    } else if (dx != 0) {
+      directions = {{dx, 0}};
+
+      if (!passable(x, y + 1)) {
+        directions.emplace_back(dx, 1);
+      }
+
+      if (!passable(x, y - 1)) {
+        directions.emplace_back(dx, -1);
+      }
+    } else {
+      directions = {{0, dy}};
+
+      if (!passable(x + 1, y)) {
+        directions.emplace_back(1, dy);
+      }
+
+      if (!passable(x - 1, y)) {
+        directions.emplace_back(-1, dy);
+      }
+    }
+
+    for (auto const& d : directions) {
+      int jx = x;
+      int jy = y;
+
+      if (!jump(jx, jy, d.first, d.second)) {
+        continue;
+      }
+
+      const int g = current.g + cost(x, y, jx, jy);
+      auto found = nodes.find(key(jx, jy));
+
+      if (found == nodes.end() ||
+          (!found->second.closed && g < found->second.g)) {
+        nodes[key(jx, jy)] = {g, x, y, false};
+        open.push({g + cost(jx, jy, x2, y2), g, jx, jy});
+      }
+    }
+  }
+
+  return {};
+}
+
+// deduces the template argument, e.g. for lambdas
+template <typename Passable>
+JumpPointSearch<Passable> makeJumpPointSearch(Passable passable) {
+  return JumpPointSearch<Passable>(passable);
+}
+
+// Moves (x, y) into the given direction up to the next jump point. Returns
+// false if there is none.
+template <typename Passable>
+bool JumpPointSearch<Passable>::jump(int& x, int& y, int dx, int dy) {
+  for (;;) {
+    x += dx;
+    y += dy;
+
+    if (!passable(x, y)) {
+      return false;
+    }
+
+    if (x == _goalX && y == _goalY) {
+      return true;
+    }
+
+    if (dx != 0 && dy != 0) {
+      // forced neighbours
+      if ((!passable(x - dx, y) && passable(x - dx, y + dy)) ||
+          (!passable(x, y - dy) && passable(x + dx, y - dy))) {
+        return true;
+      }
+
+      // a straight line starting here leads to a jump point
+      int sx = x;
+      int sy = y;
+
+      if (jump(sx, sy, dx, 0)) {
+        return true;
+      }
+
+      sx = x;
+      sy = y;
+
+      if (jump(sx, sy, 0, dy)) {
+        return true;
+      }
+    } else if (dx != 0) {
+      if ((!passable(x, y + 1) && passable(x + dx, y + 1)) ||
+          (!passable(x, y - 1) && passable(x + dx, y - 1))) {
+        return true;
+      }
+    } else {
+      if ((!passable(x + 1, y) && passable(x + 1, y + dy)) ||
+          (!passable(x - 1, y) && passable(x - 1, y + dy))) {
+        return true;
+      }
+    }
+  }
+}
+
+#endif
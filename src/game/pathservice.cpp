@@ -0,0 +1,271 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pathservice.h"
+#include "world.h"
+#include "sector.h"
+#include "entity.h"
+#include "jumppoint.h"
+#include <algorithm>
+
+const PathService::Ticket PathService::noTicket = 0;
+const int PathService::_requestsPerTurn = 16;
+const int PathService::_margin = 16;
+const int PathService::_maxMargin = 256;
+
+PathService::PathService(World& world)
+    : _world(world), _budget(_requestsPerTurn) {
+  // leave a core to the main thread
+  unsigned threads = thread::hardware_concurrency();
+  threads = (threads > 1) ? min(threads - 1, 4u) : 1;
+
+  for (unsigned i = 0; i < threads; i++) {
+    _workers.emplace_back(&PathService::work, this);
+  }
+}
+
+PathService::~PathService() {
+  {
+    lock_guard<mutex> lock(_mutex);
+    _stop = true;
+  }
+
+  _wakeUp.notify_all();
+
+  for (thread& worker : _workers) {
+    worker.join();
+  }
+}
+
+PathService::Ticket PathService::request(int x1, int y1, int x2, int y2,
+                                         bool converge) {
+  if (_budget <= 0) {
+    return noTicket;
+  }
+
+  _budget--;
+
+  Job job;
+  job.ticket = _nextTicket++;
+  job.margin = _margin;
+  job.reachable = _world.reachable(x1, y1, x2, y2, converge);
+  job.converge = converge;
+
+  // no need to search at all
+  if (!job.reachable) {
+    lock_guard<mutex> lock(_mutex);
+    _results[job.ticket] = {Command::none};
+
+    return job.ticket;
+  }
+
+  snapshot(job, x1, y1, x2, y2);
+
+  {
+    lock_guard<mutex> lock(_mutex);
+    _jobs.push(move(job));
+  }
+
+  _wakeUp.notify_one();
+
+  return _nextTicket - 1;
+}
+
+void PathService::snapshot(Job& job, int x1, int y1, int x2, int y2) {
+  // there is nothing passable beyond the edges of the world
+  const int width = _world.width() * Sector::size();
+  const int height = _world.height() * Sector::size();
+
+  job.ox = max(min(x1, x2) - job.margin, 0);
+  job.oy = max(min(y1, y2) - job.margin, 0);
+  job.width = min(max(x1, x2) + job.margin + 1, width) - job.ox;
+  job.height = min(max(y1, y2) + job.margin + 1, height) - job.oy;
+  job.whole = job.ox == 0 && job.oy == 0 && job.width == width &&
+              job.height == height;
+  job.x1 = x1 - job.ox;
+  job.y1 = y1 - job.oy;
+  job.x2 = x2 - job.ox;
+  job.y2 = y2 - job.oy;
+
+  // only copies a few pointers per sector
+  if (!_terrain) {
+    _terrain = make_shared<const Snapshot>(_world.snapshot());
+  }
+
+  job.terrain = _terrain;
+  job.blockers.clear();
+
+  // entities only live in the sectors around the player, so there are few
+  _world.spatialIndex().forEach(
+      job.ox, job.oy, job.ox + job.width, job.oy + job.height,
+      [&job](Entity* e) {
+        if (!e->t().passable()) {
+          job.blockers.emplace_back(e->x(), e->y());
+        }
+      });
+}
+
+void PathService::fill(Job& job) {
+  job.passable.resize(job.width * job.height);
+
+  for (int y = 0; y < job.height; y++) {
+    for (int x = 0; x < job.width; x++) {
+      Tile* t = job.terrain->tile(job.ox + x, job.oy + y);
+      job.passable[x + y * job.width] = t != nullptr && t->passable();
+    }
+  }
+
+  for (auto const& b : job.blockers) {
+    job.passable[b.first - job.ox + (b.second - job.oy) * job.width] = false;
+  }
+
+  job.terrain.reset();
+  job.blockers.clear();
+}
+
+void PathService::retry(Job& job) {
+  job.margin = min(4 * job.margin, _maxMargin);
+  snapshot(job, job.ox + job.x1, job.oy + job.y1, job.ox + job.x2,
+           job.oy + job.y2);
+}
+
+boost::optional<vector<Command>> PathService::result(Ticket ticket) {
+  lock_guard<mutex> lock(_mutex);
+  auto found = _results.find(ticket);
+
+  if (found == _results.end()) {
+    return boost::none;
+  }
+
+  vector<Command> route = move(found->second);
+  _results.erase(found);
+
+  return route;
+}
+
+void PathService::cancel(Ticket ticket) {
+  if (ticket == noTicket) {
+    return;
+  }
+
+  lock_guard<mutex> lock(_mutex);
+
+  // either the result is there already, or it will be dropped once it is
+  if (_results.erase(ticket) == 0) {
+    _cancelled.insert(ticket);
+  }
+}
+
+void PathService::newTurn() {
+  _budget = _requestsPerTurn;
+  _terrain.reset();
+
+  vector<Job> retries;
+
+  {
+    lock_guard<mutex> lock(_mutex);
+    swap(retries, _retries);
+  }
+
+  // retries are taken from the new budget, the rest waits for later turns
+  auto rest = retries.begin();
+
+  for (; rest != retries.end() && _budget > 0; ++rest, _budget--) {
+    retry(*rest);
+  }
+
+  lock_guard<mutex> lock(_mutex);
+
+  for (auto job = retries.begin(); job != rest; ++job) {
+    _jobs.push(move(*job));
+  }
+
+  _retries.insert(_retries.end(), make_move_iterator(rest),
+                  make_move_iterator(retries.end()));
+
+  if (rest != retries.begin()) {
+    _wakeUp.notify_all();
+  }
+}
+
+void PathService::work() {
+  for (;;) {
+    Job job;
+
+    {
+      unique_lock<mutex> lock(_mutex);
+      _wakeUp.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+
+      if (_stop) {
+        return;
+      }
+
+      job = move(_jobs.front());
+      _jobs.pop();
+    }
+
+    fill(job);
+    vector<Command> route = solve(job);
+
+    // The route may have to leave the snapshot. Unless it already reaches
+    // as far as it can, a larger one is taken on the next turn.
+    const bool retry = route.front() == Command::none && job.reachable &&
+                       !job.whole && job.margin < _maxMargin;
+
+    lock_guard<mutex> lock(_mutex);
+
+    if (_cancelled.erase(job.ticket) != 0) {
+      continue;
+    }
+
+    if (retry) {
+      job.passable.clear();
+      _retries.push_back(move(job));
+    } else {
+      _results[job.ticket] = move(route);
+    }
+  }
+}
+
+vector<Command> PathService::solve(Job const& job) {
+  auto search = makeJumpPointSearch([&job](int x, int y) {
+    if (job.converge && x == job.x2 && y == job.y2) {
+      return true;
+    }
+
+    return x >= 0 && y >= 0 && x < job.width && y < job.height &&
+           job.passable[x + y * job.width];
+  });
+
+  vector<Command> commands;
+  int x = job.x1;
+  int y = job.y1;
+
+  for (auto const& tile : search.path(job.x1, job.y1, job.x2, job.y2)) {
+    commands.push_back(direction(tile.first - x, tile.second - y));
+    x = tile.first;
+    y = tile.second;
+  }
+
+  if (commands.empty()) {
+    return {Command::none};
+  }
+
+  return commands;
+}
@@ -0,0 +1,148 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PATHSERVICE_H
+#define PATHSERVICE_H
+
+#include "command.h"
+#include "snapshot.h"
+#include <boost/optional.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+class World;
+
+/*!
+ * \brief Finds routes on worker threads.
+ *
+ * A request copies the positions of the impassable entities around start and
+ * goal. The terrain comes from a snapshot of the world shared by all requests
+ * of a turn. The worker turns both into the passability of the area, so the
+ * work on the main thread doesn't grow with the area searched, and the
+ * search doesn't touch the world while it is running. The result can be
+ * picked up with the returned ticket on a later turn; until then the
+ * requester has to make do with its previous plan.
+ *
+ * Only a limited number of requests are accepted per turn, which bounds the
+ * work done on the main thread for collecting the entities.
+ *
+ * Goals which are out of reach are answered right away. If a route exists,
+ * but has to leave the snapshot, the search is repeated on a later turn with
+ * a larger one.
+ */
+class PathService {
+ public:
+  typedef size_t Ticket;
+
+  // returned if a request was not accepted
+  static const Ticket noTicket;
+
+  PathService(World& world);
+  ~PathService();
+
+  // see World::route()
+  Ticket request(int x1, int y1, int x2, int y2, bool converge = false);
+
+  /*!
+   * \return the route found for the ticket, or none if the search hasn't
+   *	finished yet. As for World::route(), {Command::none} means there is
+   *	no route.
+   */
+  boost::optional<vector<Command>> result(Ticket ticket);
+
+  // drops a request whose result isn't needed any more
+  void cancel(Ticket ticket);
+
+  // has to be called at the start of every turn to renew the budget
+  void newTurn();
+
+ private:
+  struct Job {
+    Ticket ticket;
+
+    // how far around start and goal the snapshot reaches
+    int margin;
+    // whether World::reachable() expects there to be a route
+    bool reachable;
+
+    // origin and size of the snapshot
+    int ox;
+    int oy;
+    int width;
+    int height;
+    // handed to the worker, which turns them into passable
+    shared_ptr<const Snapshot> terrain;
+    vector<pair<int, int>> blockers;
+    vector<char> passable;
+    // true if the snapshot covers the whole world
+    bool whole;
+
+    // start and goal relative to the origin
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+    bool converge;
+  };
+
+  // collects what is needed to know the passability around start and goal
+  void snapshot(Job& job, int x1, int y1, int x2, int y2);
+  // takes a larger snapshot for a job whose route left the old one
+  void retry(Job& job);
+
+  void work();
+  static void fill(Job& job);
+  static vector<Command> solve(Job const& job);
+
+  World& _world;
+
+  // the terrain for this turn's requests; taken with the first of them
+  shared_ptr<const Snapshot> _terrain;
+
+  Ticket _nextTicket{noTicket + 1};
+  int _budget;
+
+  vector<thread> _workers;
+
+  // everything below is guarded by _mutex
+  mutex _mutex;
+  condition_variable _wakeUp;
+  bool _stop{false};
+
+  queue<Job> _jobs;
+  // jobs to be retried with a larger snapshot
+  vector<Job> _retries;
+  unordered_map<Ticket, vector<Command>> _results;
+  unordered_set<Ticket> _cancelled;
+
+  static const int _requestsPerTurn;
+  // how far around start and goal the snapshot reaches at first and at most
+  static const int _margin;
+  static const int _maxMargin;
+};
+
+#endif
@@ -28,7 +28,8 @@ using namespace std;
 const int Sector::_size = 0x20;
 
 Sector::Sector(Tile* defTile)
-    : _tiles(_size * _size, defTile), _explored(_size * _size) {}
+    : _tiles(make_shared<vector<Tile*>>(_size * _size, defTile)),
+      _explored(make_shared<vector<uint64_t>>((_size * _size + 63) / 64)) {}
 
 Sector::~Sector() {
   for (Entity* e : _entities) {
@@ -55,24 +56,42 @@ bool Sector::passable(int x, int y) {
 
 int Sector::size() { return _size; }
 
+int Sector::index(int x, int y) { return x % _size + (y % _size) * _size; }
+
+template <typename T>
+void Sector::unshare(shared_ptr<vector<T>>& page, bool& shared) {
+  // A page which has been handed out is never written to again, even if all
+  // other references to it are gone by now. The thread which held them may
+  // still be reading from it as far as this thread can tell.
+  if (shared) {
+    page = make_shared<vector<T>>(*page);
+    shared = false;
+  }
+}
+
 const list<Entity*>& Sector::entities() const { return _entities; }
 
-void Sector::addEntity(Entity* e) {
+bool Sector::drawnBefore(Entity* element, Entity* value) {
   // Entities which are passable should be drawn before those wich are not.
   // Entities which are transparent should be drawn before those wich are not.
   // This is to ensure that the impassable / opaque entities are drawn on
   // top.
-  auto comp = [](Entity* element, Entity* value) {
-    return (element->t().passable() && !value->t().passable()) ||
-           (element->t().transparent() && !value->t().transparent());
-  };
+  return (element->t().passable() && !value->t().passable()) ||
+         (element->t().transparent() && !value->t().transparent());
+}
 
-  auto pos = std::upper_bound(_entities.begin(), _entities.end(), e, comp);
+void Sector::addEntity(Entity* e) {
+  auto pos =
+      std::upper_bound(_entities.begin(), _entities.end(), e, &drawnBefore);
 
   _entities.insert(pos, e);
+  _changes++;
 }
 
-void Sector::removeEntity(Entity* e) { _entities.remove(e); }
+void Sector::removeEntity(Entity* e) {
+  _entities.remove(e);
+  _changes++;
+}
 
 vector<Entity*> Sector::entities(int x, int y) const {
   vector<Entity*> ents;
@@ -85,18 +104,91 @@ vector<Entity*> Sector::entities(int x, int y) const {
   return ents;
 }
 
+const unordered_map<int, vector<GroundItem>>& Sector::items() const {
+  return _items;
+}
+
+unordered_map<int, vector<GroundItem>>& Sector::items() {
+  _changes++;
+  return _items;
+}
+
+const vector<GroundItem>& Sector::items(int x, int y) const {
+  static const vector<GroundItem> none;
+
+  auto pile = _items.find(index(x, y));
+  return pile != _items.end() ? pile->second : none;
+}
+
+vector<GroundItem>& Sector::pile(int x, int y) {
+  _changes++;
+  return _items[index(x, y)];
+}
+
+void Sector::removeItem(int x, int y, size_t n) {
+  auto pile = _items.find(index(x, y));
+
+  if (pile != _items.end() && n < pile->second.size()) {
+    pile->second.erase(pile->second.begin() + n);
+    _changes++;
+
+    if (pile->second.empty()) {
+      _items.erase(pile);
+    }
+  }
+}
+
 bool Sector::explored(int x, int y) {
-  return _explored.at(x % _size + (y % _size) * _size);
+  const int i = index(x, y);
+  return ((*_explored)[i / 64] >> (i % 64)) & 1;
 }
 
 void Sector::setExplored(int x, int y, bool explored) {
-  _explored.at(x % _size + (y % _size) * _size) = explored;
-}
+  const int i = index(x, y);
+  const uint64_t bit = uint64_t(1) << (i % 64);
 
-Tile* Sector::tile(int x, int y) {
-  return _tiles.at(x % _size + (y % _size) * _size);
+  if (explored != bool((*_explored)[i / 64] & bit)) {
+    unshare(_explored, _exploredShared);
+    (*_explored)[i / 64] ^= bit;
+    _exploredCount += explored ? 1 : -1;
+  }
 }
 
+bool Sector::fullyExplored() const { return _exploredCount == _size * _size; }
+
+bool Sector::unexplored() const { return _exploredCount == 0; }
+
+Tile* Sector::tile(int x, int y) { return (*_tiles)[index(x, y)]; }
+
 void Sector::setTile(int x, int y, Tile* tile) {
-  _tiles.at(x % _size + (y % _size) * _size) = tile;
+  const int i = index(x, y);
+
+  if ((*_tiles)[i] != tile) {
+    unshare(_tiles, _tilesShared);
+    (*_tiles)[i] = tile;
+  }
+}
+
+Sector::Pages Sector::pages() {
+  _tilesShared = true;
+  _exploredShared = true;
+
+  return {_tiles, _explored, _exploredCount};
+}
+
+Tile* Sector::Pages::tile(int x, int y) const {
+  return (*tiles)[index(x, y)];
+}
+
+bool Sector::Pages::explored(int x, int y) const {
+  const int i = index(x, y);
+  return ((*exploredBits)[i / 64] >> (i % 64)) & 1;
 }
+
+Sector::Activity Sector::activity() const { return _activity; }
+
+void Sector::setActivity(Activity activity) { _activity = activity; }
+
+unsigned long Sector::changes() const { return _changes; }
+
+void Sector::markChanged() { _changes++; }
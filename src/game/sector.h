@@ -21,8 +21,12 @@
 
 #include "tile.h"
 #include "command.h"
+#include "grounditem.h"
 #include <vector>
 #include <list>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
 
 using namespace std;
 
@@ -32,29 +36,90 @@ class Tile;
 class Entity;
 
 class Sector {
+ public:
+  // how much simulation effort is spent on the entities in a sector
+  enum class Activity {
+    active,   // full AI
+    dormant,  // cheap, coarse simulation every turn
+    sleeping  // frozen; fast-forwarded once the sector wakes up
+  };
+
+  /*!
+   * \brief The terrain of a sector at some point in time.
+   *
+   * Pages are shared between a sector and any number of snapshots. They are
+   * never changed once shared; a sector writing to a shared page copies it
+   * first.
+   */
+  struct Pages {
+    shared_ptr<const vector<Tile*>> tiles;
+    shared_ptr<const vector<uint64_t>> exploredBits;
+    int exploredCount;
+
+    Tile* tile(int x, int y) const;
+    bool explored(int x, int y) const;
+  };
+
  private:
   // size of a sector has to be hardwired so they can be tiled
   static const int _size;
 
   // vector containing the tiles (stored linearly row for row)
-  vector<Tile*> _tiles;
-  vector<bool> _explored;
+  shared_ptr<vector<Tile*>> _tiles;
+
+  // one bit per tile, packed into 64 bit words row for row
+  shared_ptr<vector<uint64_t>> _explored;
+  // number of bits set in _explored
+  int _exploredCount{0};
+
+  // Set once a page has been handed out by pages(). The reference counts of
+  // the pages can't tell, as other threads may drop their references at any
+  // time without synchronizing with the sector.
+  bool _tilesShared{false};
+  bool _exploredShared{false};
 
   // a list of all entities in the sector (i.e. characters, items, props)
   // the bottommost entity has highest render priority
   list<Entity*> _entities;
 
+  // items lying on the ground, by x + y * size() within the sector. They are
+  // kept apart from the entities, so piles of loot don't slow down
+  // passable() and friends.
+  unordered_map<int, vector<GroundItem>> _items;
+
+  Activity _activity{Activity::sleeping};
+
+  // see changes()
+  unsigned long _changes{0};
+
+  static int index(int x, int y);
+
+  // makes sure no snapshot shares the page before it is written to
+  template <typename T>
+  static void unshare(shared_ptr<vector<T>>& page, bool& shared);
+
  public:
   Sector(Tile* defTile);
   ~Sector();
 
   static int size();
 
+  // true if element has to be drawn before (i.e. below) value
+  static bool drawnBefore(Entity* element, Entity* value);
+
   const list<Entity*>& entities() const;
   vector<Entity*> entities(int x, int y) const;
   void addEntity(Entity* e);
   void removeEntity(Entity* e);
 
+  const unordered_map<int, vector<GroundItem>>& items() const;
+  unordered_map<int, vector<GroundItem>>& items();
+  const vector<GroundItem>& items(int x, int y) const;
+  // the pile at (x, y), which is created if there is none
+  vector<GroundItem>& pile(int x, int y);
+  // removes the n-th item of the pile at (x, y)
+  void removeItem(int x, int y, size_t n);
+
   Tile* tile(int x, int y);
   void setTile(int x, int y, Tile* tile);
 
@@ -62,6 +127,23 @@ class Sector {
 
   bool explored(int x, int y);
   void setExplored(int x, int y, bool explored = true);
+
+  // summaries of the explored tiles, e.g. for a minimap
+  bool fullyExplored() const;
+  bool unexplored() const;
+
+  // cheap; only the page pointers are copied. The pages are copied again
+  // before the sector next writes to them.
+  Pages pages();
+
+  Activity activity() const;
+  void setActivity(Activity activity);
+
+  // counts the changes to the entities and items in the sector, e.g. so
+  // only changed sectors have to be saved
+  unsigned long changes() const;
+  // has to be called when an entity in the sector changes without moving
+  void markChanged();
 };
 
 #endif
@@ -0,0 +1,59 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "snapshot.h"
+
+Snapshot::Snapshot(int width, int height, double time,
+                   vector<Sector::Pages>&& pages)
+    : _width(width), _height(height), _time(time), _pages(move(pages)) {}
+
+int Snapshot::width() const { return _width; }
+
+int Snapshot::height() const { return _height; }
+
+double Snapshot::time() const { return _time; }
+
+Sector::Pages const* Snapshot::pages(int x, int y) const {
+  if (x >= 0 && y >= 0 && x < _width * Sector::size() &&
+      y < _height * Sector::size()) {
+    return &_pages[x / Sector::size() + y / Sector::size() * _width];
+  } else {
+    return nullptr;
+  }
+}
+
+Tile* Snapshot::tile(int x, int y) const {
+  Sector::Pages const* p = pages(x, y);
+
+  if (p != nullptr) {
+    return p->tile(x, y);
+  } else {
+    return nullptr;
+  }
+}
+
+bool Snapshot::explored(int x, int y) const {
+  Sector::Pages const* p = pages(x, y);
+
+  if (p != nullptr) {
+    return p->explored(x, y);
+  } else {
+    return false;
+  }
+}
@@ -0,0 +1,61 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "sector.h"
+#include <vector>
+
+using namespace std;
+
+/*!
+ * \brief A frozen copy of the terrain of a world.
+ *
+ * Taking a snapshot only copies a handful of pointers per sector; the
+ * sectors' pages are shared until the world writes to them. Snapshots don't
+ * change afterwards, so they can be read from any thread while the game goes
+ * on. Entities are not part of a snapshot.
+ */
+class Snapshot {
+ public:
+  Snapshot(int width, int height, double time, vector<Sector::Pages>&& pages);
+
+  // size of the world in sectors
+  int width() const;
+  int height() const;
+
+  // the time the snapshot was taken at
+  double time() const;
+
+  // nullptr if (x, y) is outside of the world
+  Sector::Pages const* pages(int x, int y) const;
+
+  Tile* tile(int x, int y) const;
+  bool explored(int x, int y) const;
+
+ private:
+  int _width;
+  int _height;
+  double _time;
+
+  vector<Sector::Pages> _pages;
+};
+
+#endif
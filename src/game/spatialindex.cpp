@@ -0,0 +1,88 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "spatialindex.h"
+#include "entity.h"
+#include "sector.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+const int SpatialIndex::_bucketSize = 8;
+
+SpatialIndex::SpatialIndex(int width, int height)
+    : _width((width + _bucketSize - 1) / _bucketSize),
+      _height((height + _bucketSize - 1) / _bucketSize),
+      _buckets(_width * _height) {}
+
+vector<Entity*>* SpatialIndex::bucket(int x, int y) {
+  if (x >= 0 && y >= 0 && x / _bucketSize < _width &&
+      y / _bucketSize < _height) {
+    return &_buckets[x / _bucketSize + y / _bucketSize * _width];
+  } else {
+    return nullptr;
+  }
+}
+
+void SpatialIndex::insert(Entity* e) {
+  vector<Entity*>* b = bucket(e->x(), e->y());
+
+  if (b != nullptr) {
+    auto pos = upper_bound(b->begin(), b->end(), e, &Sector::drawnBefore);
+    b->insert(pos, e);
+  }
+}
+
+void SpatialIndex::remove(Entity* e) {
+  vector<Entity*>* b = bucket(e->x(), e->y());
+
+  if (b != nullptr) {
+    auto pos = find(b->begin(), b->end(), e);
+
+    if (pos != b->end()) {
+      b->erase(pos);
+    }
+  }
+}
+
+vector<Entity*> SpatialIndex::entities(int x, int y) const {
+  return entities(x, y, x + 1, y + 1);
+}
+
+vector<Entity*> SpatialIndex::entities(int x1, int y1, int x2, int y2) const {
+  vector<Entity*> ents;
+  forEach(x1, y1, x2, y2, [&ents](Entity* e) { ents.push_back(e); });
+
+  return ents;
+}
+
+vector<Entity*> SpatialIndex::entities(int x, int y, double range) const {
+  vector<Entity*> ents;
+  const int r = static_cast<int>(ceil(range));
+
+  forEach(x - r, y - r, x + r + 1, y + r + 1, [&](Entity* e) {
+    if ((e->x() - x) * (e->x() - x) + (e->y() - y) * (e->y() - y) <=
+        range * range) {
+      ents.push_back(e);
+    }
+  });
+
+  return ents;
+}
@@ -0,0 +1,86 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include "entity.h"
+#include <vector>
+
+using namespace std;
+
+// A uniform grid of small buckets over the whole world, used to answer
+// coordinate queries without walking the entity lists of entire sectors.
+class SpatialIndex {
+ private:
+  // width and height of a bucket in tiles
+  static const int _bucketSize;
+
+  // dimensions in buckets
+  int _width;
+  int _height;
+
+  // buckets stored linearly row for row. Within a bucket the entities are
+  // kept in the same render order as in a Sector.
+  vector<vector<Entity*>> _buckets;
+
+  vector<Entity*>* bucket(int x, int y);
+
+ public:
+  // width and height are given in tiles
+  SpatialIndex(int width, int height);
+
+  // entities have to be inserted and removed using their current coordinates
+  void insert(Entity* e);
+  void remove(Entity* e);
+
+  // calls f for every entity in the rectangle [x1, x2) x [y1, y2). Unlike
+  // entities() this does not allocate.
+  template <typename F>
+  void forEach(int x1, int y1, int x2, int y2, F f) const;
+
+  vector<Entity*> entities(int x, int y) const;
+  vector<Entity*> entities(int x1, int y1, int x2, int y2) const;
+  vector<Entity*> entities(int x, int y, double range) const;
+};
+
+template <typename F>
+void SpatialIndex::forEach(int x1, int y1, int x2, int y2, F f) const {
+  if (x1 < 0) x1 = 0;
+  if (y1 < 0) y1 = 0;
+
+  if (x2 <= x1 || y2 <= y1) {
+    return;
+  }
+
+  const int bx2 = (x2 - 1) / _bucketSize;
+  const int by2 = (y2 - 1) / _bucketSize;
+
+  for (int by = y1 / _bucketSize; by <= by2 && by < _height; by++) {
+    for (int bx = x1 / _bucketSize; bx <= bx2 && bx < _width; bx++) {
+      for (Entity* e : _buckets[bx + by * _width]) {
+        if (e->x() >= x1 && e->x() < x2 && e->y() >= y1 && e->y() < y2) {
+          f(e);
+        }
+      }
+    }
+  }
+}
+
+#endif
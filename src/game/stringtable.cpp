@@ -0,0 +1,34 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "stringtable.h"
+
+using namespace std;
+
+boost::string_view StringTable::intern(boost::string_view s) {
+  // elements of an unordered_set never move, even when it is rehashed
+  return *table().emplace(s.data(), s.size()).first;
+}
+
+unordered_set<string>& StringTable::table() {
+  // constructed on first use, as tiles are interned during static
+  // initialisation
+  static unordered_set<string> table;
+  return table;
+}
@@ -0,0 +1,40 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STRINGTABLE_H
+#define STRINGTABLE_H
+
+#include <boost/utility/string_view.hpp>
+#include <string>
+#include <unordered_set>
+
+using namespace std;
+
+// Interns strings for the whole runtime of the program. Equal strings share
+// the same storage, so the returned views stay valid and can be passed
+// around without copying.
+class StringTable {
+ public:
+  static boost::string_view intern(boost::string_view s);
+
+ private:
+  static unordered_set<string>& table();
+};
+
+#endif
@@ -17,13 +17,14 @@
  */
 
 #include "tile.h"
+#include "stringtable.h"
 
 Tile::Tile(char repr, Color color, string prefix, string description,
            bool transparent, bool passable)
     : _repr(repr),
       _color(color),
-      _prefix(prefix),
-      _description(description),
+      _prefix(StringTable::intern(prefix)),
+      _description(StringTable::intern(description)),
       _transparent(transparent),
       _passable(passable) {}
 
@@ -33,8 +34,8 @@ char Tile::repr() const { return _repr; }
 
 Color Tile::color() const { return _color; }
 
-string Tile::prefix() const { return _prefix; }
+boost::string_view Tile::prefix() const { return _prefix; }
 
-string Tile::desc() const { return _description; }
+boost::string_view Tile::desc() const { return _description; }
 
 bool Tile::passable() const { return _passable; }
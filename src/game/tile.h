@@ -20,6 +20,7 @@
 #define TILE_H
 
 #include "yarlview.h"
+#include <boost/utility/string_view.hpp>
 #include <string>
 
 using namespace std;
@@ -29,8 +30,9 @@ class Tile {
   char _repr;
   Color _color;
 
-  string _prefix;
-  string _description;
+  // interned, see StringTable
+  boost::string_view _prefix;
+  boost::string_view _description;
 
   bool _transparent;
   bool _passable;
@@ -42,8 +44,8 @@ class Tile {
 
   char repr() const;
   Color color() const;
-  string prefix() const;
-  string desc() const;
+  boost::string_view prefix() const;
+  boost::string_view desc() const;
   bool passable() const;
   bool transparent() const;
 };
@@ -17,13 +17,16 @@
  */
 
 #include "world.h"
+#include "jumppoint.h"
 #include "sector.h"
 #include "character.h"
 #include "player.h"
 #include "companion.h"
+#include "npc.h"
 #include "item.h"
 #include <cmath>
 #include <algorithm>
+#include <iostream>
 
 using namespace std;
 
@@ -31,19 +34,22 @@ Tile World::_none = {' ', Color::black, "", "void"};
 Tile World::_mud = {'.', Color::red, "", "mud", true, true};
 Tile World::_grass = {',', Color::green, "a ", "patch of grass", true, true};
 Tile World::_tree = {'T', Color::green, "a ", "tree"};
-Tile World::_hero = {'@', Color::yellow, "", "you", true, false};
-Tile World::_goblin = {'g', Color::green, "a ", "goblin", true, false};
-Tile World::_dog = {'d', Color::red, "a ", "dog", true, false};
-Tile World::_dogCorpse = {'%', Color::red, "a ", "dog corpse", true, true};
-Tile World::_shortSword = {'(', Color::white, "a ", "short sword", true, true};
-Tile World::_claymore = {'(', Color::white, "a ", "claymore", true, true};
-Tile World::_leatherArmor = {'[',  Color::yellow, "a ", "leather armor",
-                             true, true};
-Tile World::_buckler = {'[',  Color::red, "a ", "light wooden shield",
-                        true, true};
-
-World::World(int width, int height)
-    : _width(width), _height(height), _sectors(width * height) {
+
+const int World::_activeRadius = 1;
+const int World::_dormantRadius = 2;
+const double World::_fullDetailRange = 12;
+const int World::_lowDetailActions = 4;
+const double World::_combatTimeout = 5;
+
+World::World(int width, int height, Archetypes const& archetypes)
+    : _width(width),
+      _height(height),
+      _archetypes(archetypes),
+      _sectors(width * height),
+      _index(width * Sector::size(), height * Sector::size()),
+      _connectivity(*this),
+      _pathService(*this),
+      _director(*this, archetypes) {
   for (Sector*& s : _sectors) {
     s = new Sector(&_grass);
 
@@ -58,38 +64,95 @@ World::World(int width, int height)
     }
   }
 
-  array<int, 6> attr = {12, 12, 12, 12, 12, 12};
-  _player = new Player(_hero, 9 + rand() % 8, 42, 42, 1, 12, attr, *this,
-                       new Attack([]() { return rand() % 2 + 1; }), {}, 1);
+  // the player archetype is required by YarlController
+  _player = static_cast<Player*>(spawn("player", 42, 42));
+
+  if (Weapon* weap = dynamic_cast<Weapon*>(spawn("short-sword"))) {
+    _player->addItem(weap);
+    _player->setMainHand(weap);
+    _player->setOffHand(weap);
+  }
+
+  if (Armor* arm = dynamic_cast<Armor*>(spawn("leather-armor"))) {
+    _player->addItem(arm);
+    _player->setArmor(arm);
+  }
+
+  spawn("buckler", 43, 43);
+  spawn("claymore", 42, 43);
+
+  spawn("dog", 45, 46);
+  spawn("goblin-dummy", 44, 43);
+  spawn("goblin", 45, 45);
+}
+
+Entity* World::spawn(Archetype const& a, int x, int y) {
+  list<Item*> inventory;
+
+  for (string const& name : a.inventory) {
+    inventory.push_back(static_cast<Item*>(spawn(name)));
+  }
+
+  array<int, Character::noOfAttributes> attr = a.attributes;
+
+  switch (a.kind) {
+    case Archetype::Kind::player:
+      return new Player(a.tile, a.hp.roll(), x, y, a.speed, a.visionRange,
+                        attr, *this, &a.attack, inventory, a.bab, a.size,
+                        a.naturalArmor);
+
+    case Archetype::Kind::character:
+      return new Character(a.tile, a.hp.roll(), x, y, a.speed, a.visionRange,
+                           attr, *this, &a.attack, inventory, a.bab, a.size,
+                           a.naturalArmor);
+
+    case Archetype::Kind::monster:
+    case Archetype::Kind::companion:
+      return new Companion(
+          a.tile, (a.kind == Archetype::Kind::companion) ? _player : nullptr,
+          a.hp.roll(), x, y, a.speed, a.visionRange, attr, *this, &a.attack,
+          inventory, a.bab, a.size, a.naturalArmor);
+
+    case Archetype::Kind::item:
+    case Archetype::Kind::weapon:
+    case Archetype::Kind::armor:
+      break;
+  }
+
+  // armor is as sturdy as it protects
+  const int hp = a.kind == Archetype::Kind::armor ? a.ac * 5 : a.hp.roll();
+
+  if (x == -1 && y == -1) {
+    return makeItem(a, hp);
+  }
+
+  // there is no need for a whole item on the ground
+  putItem(GroundItem{&a, 1, hp, false}, x, y);
+  return nullptr;
+}
 
-  Weapon* weap =
-      new Weapon(_shortSword, {[]() { return rand() % 6 + 1; }, 19, 2}, false,
-                 2, *this, 5);
-  _player->inventory().push_back(weap);
-  _player->setMainHand(weap);
-  _player->setOffHand(weap);
+Item* World::makeItem(Archetype const& a, int hp) {
+  switch (a.kind) {
+    case Archetype::Kind::weapon:
+      return new Weapon(a, *this, hp);
 
-  Armor* arm = new Armor(_leatherArmor, 2, 6, 0, false, 15, *this);
-  _player->inventory().push_back(arm);
-  _player->setArmor(arm);
+    case Archetype::Kind::armor:
+      return new Armor(a, *this, hp);
+
+    default:
+      return new Item(a, *this, hp);
+  }
+}
 
-  new Armor(_buckler, 1, 999, -1, true, 5, *this, 43, 43);
-  new Weapon(_claymore, {[]() { return rand() % 10 + 1; }, 19, 2, "smite"},
-             true, 8, *this, 5, 42, 43);
+Entity* World::spawn(string const& name, int x, int y) {
+  Archetype const* a = _archetypes.find(name);
 
-  attr = {13, 13, 15, 2, 12, 6};
-  new Companion(
-      _dog, _player, rand() % 8 + 3, 45, 46, (double)3 / 4, 12, attr, *this,
-      new Attack([]() { return rand() % 4 + 2; }),
-      {new Item(_dogCorpse, 40, *this, -1, -1, 1, Entity::Size::small)}, 2,
-      Entity::Size::small, 1);
+  if (a == nullptr) {
+    cerr << "Error: unknown archetype \"" << name << "\"\n";
+    return nullptr;
+  }
 
-  attr = {11, 15, 12, 10, 9, 6};
-  new Character(_goblin, 1000, 44, 43, 1, 1, attr, *this,
-                new Attack([]() { return rand() % 2 + 1; }));
-  new Companion(_goblin, nullptr, rand() % 10 + 2, 45, 45, 1, 12, attr, *this,
-                new Attack([]() { return rand() % 2 + 1; }), {}, 1,
-                Entity::Size::small);
+  return spawn(*a, x, y);
 }
 
 double World::distance(int x1, int y1, int x2, int y2) {
@@ -109,11 +172,12 @@ bool World::los(int x1, int y1, int x2, int y2, double range) {
 
   vector<Entity*> blocking;
 
-  for (Entity* e :
-       entities(min(x1, x2), min(y1, y2), max(x1, x2) + 1, max(y1, y2) + 1))
-    if (!e->t().transparent()) {
-      blocking.push_back(e);
-    }
+  _index.forEach(min(x1, x2), min(y1, y2), max(x1, x2) + 1, max(y1, y2) + 1,
+                 [&blocking](Entity* e) {
+                   if (!e->t().transparent()) {
+                     blocking.push_back(e);
+                   }
+                 });
 
   if (abs(dx) > abs(dy)) {  // in x direction
     int y = y1;
@@ -179,6 +243,52 @@ int heuristic(int x1, int y1, int x2, int y2) {
 // calculates a route from (x1, y2) to (x2, y2). If converge is true, the path
 // will only lead to a tile next to the destination.
 vector<Command> World::route(int x1, int y1, int x2, int y2, bool converge) {
+  _routeExpansions = 0;
+
+  // if the destination is not passable, there is no route to it.
+  if (!passable(x2, y2) && !converge) {
+    return {Command::none};
+  }
+
+  // don't search the whole map for a goal that is walled off
+  if (!reachable(x1, y1, x2, y2, converge)) {
+    return {Command::none};
+  }
+
+  if (_pathfinder == Pathfinder::jumpPoint) {
+    return jumpPointRoute(x1, y1, x2, y2, converge);
+  } else {
+    return aStarRoute(x1, y1, x2, y2, converge);
+  }
+}
+
+vector<Command> World::jumpPointRoute(int x1, int y1, int x2, int y2,
+                                      bool converge) {
+  auto search = makeJumpPointSearch([this, x2, y2, converge](int x, int y) {
+    return passable(x, y) || (converge && x == x2 && y == y2);
+  });
+
+  vector<Command> commands;
+  int x = x1;
+  int y = y1;
+
+  for (auto const& tile : search.path(x1, y1, x2, y2)) {
+    commands.push_back(direction(tile.first - x, tile.second - y));
+    x = tile.first;
+    y = tile.second;
+  }
+
+  _routeExpansions = search.expansions();
+
+  if (commands.empty()) {
+    return {Command::none};
+  }
+
+  return commands;
+}
+
+vector<Command> World::aStarRoute(int x1, int y1, int x2, int y2,
+                                  bool converge) {
   // A* search (see http://en.wikipedia.org/wiki/A*_search_algorithm)
 
   typedef struct Node {
@@ -189,11 +299,6 @@ vector<Command> World::route(int x1, int y1, int x2, int y2, bool converge) {
     pair<int, int> c;  // coordinates
   } Node;
 
-  // if the destination is not passable, there is no route to it.
-  if (!passable(x2, y2) && !converge) {
-    return {Command::none};
-  }
-
   // frontier is a priority queue initialised with the starting point
   list<Node*> frontier;
 
@@ -241,6 +346,7 @@ vector<Command> World::route(int x1, int y1, int x2, int y2, bool converge) {
     }
 
     explored.push_back(node);
+    _routeExpansions++;
 
     // get all the adjacent nodes
     // I hope this wall of text can somehow be broken down...
@@ -366,10 +472,44 @@ vector<Command> World::route(int x1, int y1, int x2, int y2, bool converge) {
   }
 }
 
+bool World::reachable(int x1, int y1, int x2, int y2, bool converge) {
+  const int start = _connectivity.region(x1, y1);
+
+  if (start < 0) {
+    return false;
+  }
+
+  if (!converge) {
+    return _connectivity.region(x2, y2) == start;
+  }
+
+  for (int dy = -1; dy <= 1; dy++) {
+    for (int dx = -1; dx <= 1; dx++) {
+      if (_connectivity.region(x2 + dx, y2 + dy) == start) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+PathService& World::pathService() { return _pathService; }
+
+World::Pathfinder World::pathfinder() const { return _pathfinder; }
+
+void World::setPathfinder(Pathfinder pathfinder) { _pathfinder = pathfinder; }
+
+size_t World::routeExpansions() const { return _routeExpansions; }
+
+int World::width() const { return _width; }
+
+int World::height() const { return _height; }
+
 Sector* World::sector(int x, int y) const {
   if (x >= 0 && y >= 0 && x < _width * Sector::size() &&
       y < _height * Sector::size()) {
-    return _sectors.at(x / Sector::size() + y / Sector::size() * _width);
+    return _sectors[x / Sector::size() + y / Sector::size() * _width];
   } else {
     return nullptr;
   }
@@ -377,6 +517,21 @@ Sector* World::sector(int x, int y) const {
 
 Player* World::player() const { return _player; }
 
+Snapshot World::snapshot() const {
+  vector<Sector::Pages> pages;
+  pages.reserve(_sectors.size());
+
+  for (Sector* s : _sectors) {
+    pages.push_back(s->pages());
+  }
+
+  return Snapshot(_width, _height, _time, move(pages));
+}
+
+void World::setAutosave(std::unique_ptr<Autosave>&& autosave) {
+  _autosave = move(autosave);
+}
+
 Tile* World::tile(int x, int y) const {
   Sector* s = sector(x, y);
 
@@ -391,7 +546,8 @@ void World::setTile(int x, int y, Tile* t) {
   Sector* s = sector(x, y);
 
   if (s != nullptr) {
-    return s->setTile(x, y, t);
+    s->setTile(x, y, t);
+    _connectivity.invalidate(x, y);
   }
 }
 
@@ -414,77 +570,257 @@ void World::setExplored(int x, int y, bool explored) {
 }
 
 bool World::passable(int x, int y) {
-  Sector* s = sector(x, y);
+  Tile* t = tile(x, y);
 
-  if (s != nullptr) {
-    return s->passable(x, y);
-  } else {
+  if (t == nullptr || !t->passable()) {
     return false;
   }
+
+  bool passable = true;
+
+  _index.forEach(x, y, x + 1, y + 1, [&passable](Entity* e) {
+    if (!e->t().passable()) {
+      passable = false;
+    }
+  });
+
+  return passable;
+}
+
+vector<Entity*> World::entities(int x, int y) { return _index.entities(x, y); }
+
+vector<Entity*> World::entities(int x1, int y1, int x2, int y2) {
+  return _index.entities(x1, y1, x2, y2);
+}
+
+// returns all entities within range of (x, y)
+vector<Entity*> World::entities(int x, int y, double range) {
+  return _index.entities(x, y, range);
 }
 
-vector<Entity*> World::entities(int x, int y) {
+SpatialIndex& World::spatialIndex() { return _index; }
+
+void World::addEntitiy(Entity* e) { e->setSector(sector(e->x(), e->y())); }
+
+void World::removeEntity(Entity* e) { e->setSector(nullptr); }
+
+const vector<GroundItem>& World::items(int x, int y) const {
+  static const vector<GroundItem> none;
+
   Sector* s = sector(x, y);
+  return s != nullptr ? s->items(x, y) : none;
+}
 
-  if (s != nullptr) {
-    return s->entities(x, y);
-  } else {
-    return vector<Entity*>();
+void World::forEachPile(int x1, int y1, int x2, int y2,
+                        function<void(int, int, vector<GroundItem>&)> f) {
+  x1 = max(x1, 0);
+  y1 = max(y1, 0);
+  x2 = min(x2, _width * Sector::size());
+  y2 = min(y2, _height * Sector::size());
+
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+
+  for (int sy = y1 / Sector::size(); sy <= (y2 - 1) / Sector::size(); sy++) {
+    for (int sx = x1 / Sector::size(); sx <= (x2 - 1) / Sector::size(); sx++) {
+      for (auto& pile : _sectors[sx + sy * _width]->items()) {
+        const int x = sx * Sector::size() + pile.first % Sector::size();
+        const int y = sy * Sector::size() + pile.first / Sector::size();
+
+        if (x >= x1 && y >= y1 && x < x2 && y < y2) {
+          f(x, y, pile.second);
+        }
+      }
+    }
   }
 }
 
-vector<Entity*> World::entities(int x1, int y1, int x2, int y2) {
-  vector<Entity*> ents;
+void World::putItem(GroundItem const& i, int x, int y) {
+  Sector* s = sector(x, y);
 
-  for (int x = x1; x < x2 + Sector::size(); x += Sector::size()) {
-    for (int y = y1; y < y2 + Sector::size(); y += Sector::size()) {
-      Sector* s = sector(x, y);
+  if (s == nullptr) {
+    // there is no ground to put it on
+    return;
+  }
 
-      if (s)
-        for (Entity* e : s->entities())
-          if (e->x() >= x1 && e->x() < x2 && e->y() >= y1 && e->y() < y2) {
-            ents.push_back(e);
-          }
+  vector<GroundItem>& pile = s->pile(x, y);
+
+  for (GroundItem& stack : pile) {
+    if (stack.stacksWith(i)) {
+      stack.count += i.count;
+      return;
     }
   }
 
-  return ents;
+  pile.push_back(i);
+}
+
+void World::putItem(Item* i, int x, int y) {
+  putItem(GroundItem{&i->archetype(), i->count(), i->hp(), false}, x, y);
+  retire(i);
 }
 
-void World::addEntitiy(Entity* e) {
-  Sector* s = sector(e->x(), e->y());
+Item* World::takeItem(int x, int y, size_t n) {
+  Sector* s = sector(x, y);
 
-  if (s != nullptr) {
-    s->addEntity(e);
+  if (s == nullptr || n >= s->items(x, y).size()) {
+    return nullptr;
   }
+
+  GroundItem const i = s->items(x, y)[n];
+  s->removeItem(x, y, n);
+
+  Item* item = makeItem(*i.archetype, i.hp);
+  item->setCount(i.count);
+
+  return item;
 }
 
-void World::removeEntity(Entity* e) {
-  if (e->sector() != nullptr) {
-    e->sector()->removeEntity(e);
+double World::time() { return _time; }
+
+void World::retire(Entity* e) {
+  // the player is kept around for the view to show the end of the game
+  if (e != _player) {
+    _graveyard.push_back(e);
   }
 }
 
-double World::time() { return _time; }
+void World::reclaim() {
+  if (_graveyard.empty() || eventAvailable()) {
+    return;
+  }
+
+  // anyone might remember the dead, e.g. as their last target
+  for (Sector* s : _sectors) {
+    for (Entity* e : s->entities()) {
+      for (Entity* dead : _graveyard) {
+        e->forget(dead);
+      }
+    }
+  }
+
+  for (Entity* dead : _graveyard) {
+    _director.forget(dead);
+    delete dead;
+  }
+
+  _graveyard.clear();
+}
 
 void World::letTimePass(double time) { _time += time; }
 
+bool World::fullDetail(NPC const* n) const {
+  if (distance(n->x(), n->y(), _player->x(), _player->y()) <=
+      _fullDetailRange) {
+    return true;
+  }
+
+  // fighting; the last attacker and target are kept long after a fight is
+  // over, so only recent attacks count
+  if (_time - n->lastCombat() <= _combatTimeout) {
+    return true;
+  }
+
+  // the most expensive test comes last
+  return _player->los(*n);
+}
+
 void World::think() {
-  for (Entity* e :
-       entities(_player->x() - Sector::size(), _player->y() - Sector::size(),
-                _player->x() + Sector::size(), _player->y() + Sector::size())) {
-    if (NPC* n = dynamic_cast<NPC*>(e)) {
-      double lastAction;
+  _pathService.newTurn();
+
+  const int px = _player->x() / Sector::size();
+  const int py = _player->y() / Sector::size();
+
+  // Only the sectors around the player are awake. Those the player just left
+  // are visited once more to fall asleep; all other sectors are left alone.
+  for (int sy = max(py - _dormantRadius, 0);
+       sy <= min(py + _dormantRadius, _height - 1); sy++) {
+    for (int sx = max(px - _dormantRadius, 0);
+         sx <= min(px + _dormantRadius, _width - 1); sx++) {
+      think(sx, sy, px, py);
+    }
+  }
+
+  if (_centerX != -1 && (_centerX != px || _centerY != py)) {
+    for (int sy = max(_centerY - _dormantRadius, 0);
+         sy <= min(_centerY + _dormantRadius, _height - 1); sy++) {
+      for (int sx = max(_centerX - _dormantRadius, 0);
+           sx <= min(_centerX + _dormantRadius, _width - 1); sx++) {
+        if (max(abs(sx - px), abs(sy - py)) > _dormantRadius) {
+          think(sx, sy, px, py);
+        }
+      }
+    }
+  }
+
+  _centerX = px;
+  _centerY = py;
+
+  if (_autosave) {
+    _autosave->endTurn(*this);
+  }
+}
+
+void World::think(int sx, int sy, int px, int py) {
+  Sector* s = _sectors.at(sx + sy * _width);
+  const int d = max(abs(sx - px), abs(sy - py));
+
+  Sector::Activity activity = Sector::Activity::sleeping;
+
+  if (d <= _activeRadius) {
+    activity = Sector::Activity::active;
+  } else if (d <= _dormantRadius) {
+    activity = Sector::Activity::dormant;
+  }
 
-      do {
-        lastAction = n->lastAction();
+  // sleeping populations only exist within the director
+  if (s->activity() == Sector::Activity::sleeping &&
+      activity != Sector::Activity::sleeping) {
+    _director.wake(sx, sy);
+  } else if (s->activity() != Sector::Activity::sleeping &&
+             activity == Sector::Activity::sleeping) {
+    _director.sleep(sx, sy);
+  }
+
+  // sleeping sectors cost nothing; their npcs simply keep track of when
+  // they last acted and are fast-forwarded once the sector wakes up.
+  if (activity != Sector::Activity::sleeping) {
+    // npcs may wander into other sectors while thinking
+    vector<Entity*> ents(s->entities().begin(), s->entities().end());
+
+    for (Entity* e : ents) {
+      NPC* n = dynamic_cast<NPC*>(e);
+
+      if (n == nullptr || n->hp() <= 0) {
+        continue;
+      }
 
-        if (n->hp() > 0 && lastAction < _time) {
-          n->think();
+      if (activity == Sector::Activity::active &&
+          s->activity() != Sector::Activity::sleeping && fullDetail(n)) {
+        double lastAction;
+
+        do {
+          lastAction = n->lastAction();
+
+          if (n->hp() > 0 && lastAction < _time) {
+            n->think();
+          }
+        } while (lastAction != n->lastAction());
+      } else if (activity == Sector::Activity::active &&
+                 s->activity() != Sector::Activity::sleeping) {
+        // out of the player's attention: catch up every few actions
+        if (_time - n->lastAction() >= _lowDetailActions * n->speed()) {
+          n->coarseThink(_time - n->lastAction());
         }
-      } while (lastAction != n->lastAction());
+      } else if (n->lastAction() < _time) {
+        // dormant or just woken up: catch up in a single step
+        n->coarseThink(_time - n->lastAction());
+      }
     }
   }
+
+  s->setActivity(activity);
 }
 
 bool World::eventAvailable() const { return !_events.empty(); }
@@ -23,7 +23,16 @@
 #include "tile.h"
 #include "weapon.h"
 #include "armor.h"
+#include "grounditem.h"
 #include "event.h"
+#include "spatialindex.h"
+#include "connectivity.h"
+#include "pathservice.h"
+#include "snapshot.h"
+#include "autosave.h"
+#include "archetypes.h"
+#include "director.h"
+#include <functional>
 #include <vector>
 #include <queue>
 #include <memory>
@@ -32,19 +41,58 @@ class Sector;
 class Character;
 class Entity;
 class Player;
+class NPC;
+class Item;
 
 class World {
  public:
-  World(int width, int height);
+  // algorithms route() can use
+  enum class Pathfinder {
+    // doesn't count the cost of the steps taken so far, so it expands few
+    // nodes, but its routes may cost a little more than necessary
+    aStar,
+    // jump point search; finds the cheapest routes. See bench/routebench.
+    jumpPoint
+  };
+
+  World(int width, int height, Archetypes const& archetypes);
 
   static double distance(int x1, int y1, int x2, int y2);
 
   bool los(int x1, int y1, int x2, int y2, double range = -1);
   vector<Command> route(int x1, int y1, int x2, int y2, bool converge = false);
 
+  /*!
+   * \brief Checks whether there may be a route between two tiles.
+   *
+   * Only the terrain is taken into account, so this is cheap. If converge is
+   * true, reaching any tile next to (x2, y2) suffices.
+   */
+  bool reachable(int x1, int y1, int x2, int y2, bool converge = false);
+
+  // for finding routes without blocking the caller
+  PathService& pathService();
+
+  Pathfinder pathfinder() const;
+  void setPathfinder(Pathfinder pathfinder);
+
+  // number of nodes expanded by the last call to route(), e.g. to compare
+  // the pathfinders
+  size_t routeExpansions() const;
+
+  // size of the world in sectors
+  int width() const;
+  int height() const;
+
   Sector* sector(int x, int y) const;
   Player* player() const;
 
+  // a frozen copy of the terrain, e.g. for other threads to work on
+  Snapshot snapshot() const;
+
+  // the world is autosaved at the end of turns if set
+  void setAutosave(std::unique_ptr<Autosave>&& autosave);
+
   Tile* tile(int x, int y) const;
   void setTile(int x, int y, Tile* t);
 
@@ -55,9 +103,54 @@ class World {
 
   vector<Entity*> entities(int x, int y);
   vector<Entity*> entities(int x1, int y1, int x2, int y2);
+  vector<Entity*> entities(int x, int y, double range);
+  SpatialIndex& spatialIndex();
   void addEntitiy(Entity* e);
   void removeEntity(Entity* e);
 
+  /*!
+   * \brief Creates an entity from an archetype.
+   *
+   * Characters are placed at (x, y). Items are put on the ground there, or
+   * kept off the map if x and y are -1.
+   *
+   * \return the new entity, or nullptr if an item was put on the ground.
+   */
+  Entity* spawn(Archetype const& archetype, int x = -1, int y = -1);
+  // prints an error and returns nullptr if there is no such archetype
+  Entity* spawn(string const& name, int x = -1, int y = -1);
+
+  // items lying on the ground; they are not among the entities
+  const vector<GroundItem>& items(int x, int y) const;
+  // calls f with the position of every pile in the rectangle
+  void forEachPile(int x1, int y1, int x2, int y2,
+                   function<void(int, int, vector<GroundItem>&)> f);
+
+  // stacks the items with a like stack at (x, y) if there is one
+  void putItem(GroundItem const& i, int x, int y);
+  /*!
+   * \brief Puts an item on the ground.
+   *
+   * Only a GroundItem is kept; the item itself is retired, so it stays
+   * around for the events referring to it until the next reclaim().
+   */
+  void putItem(Item* i, int x, int y);
+  // picks the n-th item of the pile at (x, y) up; returns nullptr if there
+  // is no such item
+  Item* takeItem(int x, int y, size_t n);
+
+  /*!
+   * \brief Schedules an entity which has left the game for deletion.
+   *
+   * This happens to dead entities, items merged into a stack and monsters
+   * whose sector has fallen asleep.
+   *
+   * The entity is deleted by the next reclaim() once all events have been
+   * handled, as they may still refer to it.
+   */
+  void retire(Entity* e);
+  void reclaim();
+
   double time();
   void letTimePass(double time);
   void think();
@@ -70,30 +163,68 @@ class World {
   int _width;
   int _height;
 
+  Archetypes const& _archetypes;
+
   std::vector<Sector*> _sectors;
 
+  // kept up to date by Entity::setSector
+  SpatialIndex _index;
+
+  // kept up to date by setTile
+  Connectivity _connectivity;
+
+  Pathfinder _pathfinder{Pathfinder::aStar};
+  size_t _routeExpansions{0};
+
+  PathService _pathService;
+
+  std::unique_ptr<Autosave> _autosave;
+
+  // populates sectors as they wake up
+  Director _director;
+
+  vector<Command> aStarRoute(int x1, int y1, int x2, int y2, bool converge);
+  vector<Command> jumpPointRoute(int x1, int y1, int x2, int y2,
+                                 bool converge);
+
   Player* _player;
 
   double _time{0};
 
   std::queue<std::unique_ptr<Event>> _events;
 
-  static Tile _grass;
-  static Tile _mud;
-  static Tile _tree;
-  static Tile _none;
+  // dead entities waiting to be deleted
+  vector<Entity*> _graveyard;
 
-  static Tile _hero;
+  // sectors up to this many sectors away from the player's are simulated in
+  // full / coarsely. Anything further away is put to sleep.
+  static const int _activeRadius;
+  static const int _dormantRadius;
 
-  static Tile _goblin;
+  // Npcs in active sectors are only simulated in full if they are this close
+  // to the player, seen by the player or fighting, i.e. have attacked or been
+  // attacked within the timeout. All others are advanced coarsely, and only
+  // once they are due for this many actions.
+  static const double _fullDetailRange;
+  static const int _lowDetailActions;
+  static const double _combatTimeout;
 
-  static Tile _dog;
-  static Tile _dogCorpse;
+  bool fullDetail(NPC const* n) const;
 
-  static Tile _shortSword;
-  static Tile _claymore;
-  static Tile _leatherArmor;
-  static Tile _buckler;
+  // the sector the player was in at the last think(); -1 before the first
+  int _centerX{-1};
+  int _centerY{-1};
+  // updates the activity of a sector, given the player's sector, and lets
+  // its npcs act
+  void think(int sx, int sy, int px, int py);
+
+  // creates an item off the map
+  Item* makeItem(Archetype const& a, int hp);
+
+  static Tile _grass;
+  static Tile _mud;
+  static Tile _tree;
+  static Tile _none;
 };
 
 #endif
@@ -19,16 +19,20 @@
 #include "consoleyarlview.h"
 #include "yarlcontroller.h"
 #include "player.h"
+#include "inventory.h"
+#include "item.h"
 #include "command.h"
 #include "attackevent.h"
 #include "deathevent.h"
 #include "dropevent.h"
 #include <boost/range/adaptor/reversed.hpp>
-#include <SDL2/SDL.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <map>
 
+const int ConsoleYarlView::_statusLines = 3;
+
 ConsoleYarlView::ConsoleYarlView(YarlController& controller, World& world)
     : _controller(controller), _world(world) {}
 
@@ -52,6 +56,17 @@ void ConsoleYarlView::run() {
                {'b', Command::southWest},
                {'n', Command::southEast},
 
+               {'H', Command::runWest},
+               {'L', Command::runEast},
+               {'K', Command::runNorth},
+               {'J', Command::runSouth},
+               {'Y', Command::runNorthWest},
+               {'U', Command::runNorthEast},
+               {'B', Command::runSouthWest},
+               {'N', Command::runSouthEast},
+               {'_', Command::travel},
+               {'o', Command::explore},
+
                {'.', Command::wait},
 
                {'f', Command::twoWeaponFightingToggle},
@@ -64,13 +79,19 @@ void ConsoleYarlView::run() {
                {'i', Command::inventory},
 
                {'/', Command::examine},
+               {'p', Command::messageLog},
+               {'M', Command::minimap},
+
+               {'\x1b', Command::cancel},
 
                {'q', Command::quit}};
 
   _running = true;
+  resizeBuffers();
 
   while (_running) {
     handleEvents();
+    _world.reclaim();
     draw();  // render the main game screen
 
     char const c = getChar();
@@ -91,6 +112,25 @@ void ConsoleYarlView::run() {
           _controller.moveCommand(cmd->second);
           break;
 
+        case Command::runWest:
+        case Command::runEast:
+        case Command::runNorth:
+        case Command::runSouth:
+        case Command::runNorthWest:
+        case Command::runNorthEast:
+        case Command::runSouthWest:
+        case Command::runSouthEast:
+          _controller.run(cmd->second);
+          break;
+
+        case Command::travel:
+          _controller.travel();
+          break;
+
+        case Command::explore:
+          _controller.explore();
+          break;
+
         case Command::twoWeaponFightingToggle:
           _controller.twoWeaponFightingToggle();
           break;
@@ -119,6 +159,14 @@ void ConsoleYarlView::run() {
           _controller.examine();
           break;
 
+        case Command::messageLog:
+          _controller.showMessageLog();
+          break;
+
+        case Command::minimap:
+          _controller.showMinimap();
+          break;
+
         case Command::quit:
           _controller.quit();
           break;
@@ -205,41 +253,38 @@ int ConsoleYarlView::multipleChoiceDialog(
 }
 
 Item* ConsoleYarlView::promptItem(const string& message,
-                                  std::list<Item*>::iterator first,
-                                  std::list<Item*>::iterator last,
+                                  Inventory const& inventory,
                                   std::function<bool(Item*)> pred) {
-  // filter all valid items
-  std::vector<Item*> possibleItems;
-  std::remove_copy_if(first, last, std::back_inserter(possibleItems),
-                      [pred](Item* i) { return !pred(i); });
-
   // show prompt
   moveAddString(0, 0, message);
 
   std::string buffer;
 
-  unsigned int index = 0;
+  std::vector<Item*> matches;
+  size_t index = 0;
+  bool inputChanged = true;
 
   while (true) {
     clear(message.size(), 0, width() - cursorX(), 1);
 
-    auto validItem = [&buffer](Item* i) {
-      return i->desc().substr(0, buffer.size()) == buffer;
-    };
-
-    // get a matching item
-    auto item = std::find_if(first, last, validItem);
-
-    for (size_t i = 0; i < index; ++i) {
-      item = std::find_if(++item, last, validItem);
+    // get all valid items matching the input
+    if (inputChanged) {
+      matches = inventory.withPrefix(buffer);
+      matches.erase(std::remove_if(matches.begin(), matches.end(),
+                                   [&pred](Item* i) { return !pred(i); }),
+                    matches.end());
+      index = 0;
+      inputChanged = false;
     }
 
+    Item* item = (index < matches.size()) ? matches[index] : nullptr;
+
     // show user input
     if (!buffer.empty()) {
       moveAddString(message.size() + 1, 0, buffer, Color::cyan);
 
-      if (item != last) {
-        addString((*item)->desc().substr(buffer.size()));
+      if (item != nullptr) {
+        addString(item->desc().substr(buffer.size()).to_string());
       }
     }
 
@@ -249,35 +294,28 @@ Item* ConsoleYarlView::promptItem(const string& message,
 
     switch (input) {
       case '\n':
-        if (item != last) {  // item found
-          return *item;
-        } else {  // no item found
-          if (buffer.empty()) {
-            addStatusMessage("Never mind.");
-          }
-
-          return nullptr;
+        if (item == nullptr && buffer.empty()) {  // no item found
+          addStatusMessage("Never mind.");
         }
-        break;
+
+        return item;
 
       case '\t':
-        if (std::find_if(++item, last, [&buffer](Item* i) {
-              return i->desc().substr(0, buffer.size()) == buffer;
-            }) != last) {
-          index++;
-        } else {
-          index = 0;
+        if (!matches.empty()) {
+          index = (index + 1) % matches.size();
         }
         break;
 
       case '\b':
         if (!buffer.empty()) {
           buffer.pop_back();
+          inputChanged = true;
         }
         break;
 
       default:
         buffer.push_back(input);
+        inputChanged = true;
         break;
     }
   }
@@ -286,7 +324,7 @@ Item* ConsoleYarlView::promptItem(const string& message,
 }
 
 void ConsoleYarlView::showItemList(std::string const& title,
-                                   std::list<Item*> const& items,
+                                   Inventory const& items,
                                    std::function<std::string(Item*)> decorate) {
   clear(0, 0, width(), 1);
   moveAddString(0, 0, title);
@@ -374,20 +412,216 @@ boost::optional<std::pair<int, int>> ConsoleYarlView::promptCoordinates() {
   }
 }
 
+void ConsoleYarlView::showMessageLog() {
+  const size_t rows = height() - 1;
+  size_t scroll = 0;  // lines scrolled back from the newest message
+
+  while (true) {
+    clear(0, 0, width(), height());
+    moveAddString(0, 0, "Messages");
+
+    // draw the newest lines at the bottom, going back in time upwards
+    size_t line = 0;
+
+    for (size_t age = 0; age < _statusBar.size() && line < scroll + rows;
+         age++) {
+      auto const& lines = _statusBar.lines(age, width() - 2);
+
+      for (auto l = lines.rbegin(); l != lines.rend() && line < scroll + rows;
+           ++l, ++line) {
+        if (line >= scroll) {
+          moveAddString(1, height() - 1 - (line - scroll), *l);
+        }
+      }
+    }
+
+    refreshScreen();
+
+    auto cmd = _bindings.find(getChar());
+
+    if (cmd != _bindings.end() && cmd->second == Command::north &&
+        line == scroll + rows) {
+      scroll++;
+    } else if (cmd != _bindings.end() && cmd->second == Command::south &&
+               scroll > 0) {
+      scroll--;
+    } else if (cmd == _bindings.end() ||
+               (cmd->second != Command::north &&
+                cmd->second != Command::south)) {
+      return;
+    }
+  }
+}
+
+/*!
+ * \brief Draws one character per sector, centered on the player's sector.
+ */
+void ConsoleYarlView::showMinimap() {
+  Player const* player = _world.player();
+  const int px = player->x() / Sector::size();
+  const int py = player->y() / Sector::size();
+
+  clear(0, 0, width(), height());
+  moveAddString(0, 0, "Map");
+
+  const int offX = width() / 2 - px;
+  const int offY = height() / 2 - py;
+
+  for (int row = 1; row < height(); row++) {
+    const int sy = row - offY;
+
+    if (sy < 0 || sy >= _world.height()) {
+      continue;
+    }
+
+    for (int col = std::max(0, offX);
+         col < width() && col - offX < _world.width(); col++) {
+      Sector const* s = _world.sector((col - offX) * Sector::size(),
+                                      sy * Sector::size());
+
+      if (col - offX == px && sy == py) {
+        moveAddChar(col, row, '@', Color::white);
+      } else if (s->fullyExplored()) {
+        moveAddChar(col, row, '#', Color::green);
+      } else if (!s->unexplored()) {
+        moveAddChar(col, row, '+', Color::yellow);
+      }
+    }
+  }
+
+  refreshScreen();
+  getChar();
+}
+
 void ConsoleYarlView::addStatusMessage(string const& message) {
   _statusBar.addMessage(message);
 }
 
+int ConsoleYarlView::cursorX() const { return _cursX; }
+
+int ConsoleYarlView::cursorY() const { return _cursY; }
+
+void ConsoleYarlView::addChar(char c, Color col) {
+  if (_cursY >= _bufHeight) {
+    return;
+  }
+
+  // the color of a blank does not matter, so don't let it cause an update
+  _cells[_cursX + _cursY * _bufWidth] = {c, c == ' ' ? Color::white : col};
+
+  _cursX++;
+
+  if (_cursX >= _bufWidth) {
+    _cursX = 0;
+    _cursY++;
+  }
+}
+
+void ConsoleYarlView::addString(string const& s, Color col) {
+  for (char c : s) {
+    addChar(c, col);
+  }
+}
+
+void ConsoleYarlView::moveCursor(int x, int y) {
+  _cursX = std::max(0, std::min(x, _bufWidth - 1));
+  _cursY = std::max(0, std::min(y, _bufHeight));
+}
+
 void ConsoleYarlView::moveAddChar(int x, int y, char c, Color col) {
   moveCursor(x, y);
   addChar(c, col);
 }
 
-void ConsoleYarlView::moveAddString(int x, int y, string s, Color col) {
+void ConsoleYarlView::moveAddString(int x, int y, string const& s,
+                                   Color col) {
   moveCursor(x, y);
   addString(s, col);
 }
 
+void ConsoleYarlView::clear(int x, int y, int w, int h) {
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  w = std::min(w, _bufWidth - x);
+  h = std::min(h, _bufHeight - y);
+
+  for (int j = 0; j < h; j++) {
+    for (int i = 0; i < w; i++) {
+      _cells[x + i + (y + j) * _bufWidth] = {' ', Color::white};
+    }
+  }
+}
+
+void ConsoleYarlView::refreshScreen() {
+  _runs.clear();
+
+  for (int y = 0; y < _bufHeight; y++) {
+    int x = 0;
+
+    while (x < _bufWidth) {
+      size_t i = x + y * _bufWidth;
+
+      if (_cells[i] == _shown[i]) {
+        x++;
+        continue;
+      }
+
+      Run run{x, y, "", _cells[i].col};
+
+      // Extend the run over all following changes of the same color. Short
+      // gaps of unchanged cells in that color are bridged as well, as
+      // rewriting them is cheaper than moving the cursor past them.
+      int end = x;
+      for (int j = x; j < _bufWidth && j - end <= 4; j++) {
+        Cell const& cell = _cells[j + y * _bufWidth];
+
+        if (cell.col != run.col) {
+          break;
+        }
+
+        if (cell != _shown[j + y * _bufWidth]) {
+          end = j + 1;
+        }
+      }
+
+      for (int j = x; j < end; j++) {
+        run.s.push_back(_cells[j + y * _bufWidth].c);
+        _shown[j + y * _bufWidth] = _cells[j + y * _bufWidth];
+      }
+
+      _runs.push_back(std::move(run));
+      x = end;
+    }
+  }
+
+  // group the runs by color, so the backend has to switch colors as rarely as
+  // possible
+  std::stable_sort(_runs.begin(), _runs.end(), [](Run const& a, Run const& b) {
+    return a.col < b.col;
+  });
+
+  for (Run const& run : _runs) {
+    drawRun(run.x, run.y, run.s, run.col);
+  }
+
+  present(_cursX, _cursY);
+}
+
+void ConsoleYarlView::resizeBuffers() {
+  if (width() == _bufWidth && height() == _bufHeight) {
+    return;
+  }
+
+  _bufWidth = width();
+  _bufHeight = height();
+
+  _cells.assign(_bufWidth * _bufHeight, {' ', Color::white});
+  // nothing is known to be shown, so everything is redrawn
+  _shown.assign(_bufWidth * _bufHeight, {'\0', Color::white});
+
+  moveCursor(_cursX, _cursY);
+}
+
 void ConsoleYarlView::handleEvents() {
   while (_world.eventAvailable()) {
     std::unique_ptr<Event> event = _world.getEvent();
@@ -397,19 +631,19 @@ void ConsoleYarlView::handleEvents() {
     if (AttackEvent* attack = dynamic_cast<AttackEvent*>(event.get())) {
       // player attacks
       if (&attack->attacker == player) {
-        addStatusMessage(std::string("You ") + (attack->hit ? "hit" : "miss") +
-                         " the " + attack->target.desc() + '.');
+        addStatusMessage({"You ", attack->hit ? "hit" : "miss", " the ",
+                          attack->target.desc(), "."});
       }
       // player is attacked
       else if (&attack->target == player) {
-        addStatusMessage("The " + attack->attacker.desc() +
-                         (attack->hit ? " hits" : " misses") + " you.");
+        addStatusMessage({"The ", attack->attacker.desc(),
+                          attack->hit ? " hits" : " misses", " you."});
       }
       // player is witnessing an attack
       else if (player->los(attack->attacker) && player->los(attack->target)) {
-        addStatusMessage("The " + attack->attacker.desc() +
-                         (attack->hit ? " hits" : " misses") + " the " +
-                         attack->target.desc() + '.');
+        addStatusMessage({"The ", attack->attacker.desc(),
+                          attack->hit ? " hits" : " misses", " the ",
+                          attack->target.desc(), "."});
       }
     }
 
@@ -420,9 +654,9 @@ void ConsoleYarlView::handleEvents() {
         _running = false;
       } else if (player->los(death->victim)) {
         if (dynamic_cast<Character const*>(&death->victim)) {
-          addStatusMessage("The " + death->victim.desc() + " dies.");
+          addStatusMessage({"The ", death->victim.desc(), " dies."});
         } else {
-          addStatusMessage("The " + death->victim.desc() + " is destroyed.");
+          addStatusMessage({"The ", death->victim.desc(), " is destroyed."});
         }
       }
     }
@@ -431,10 +665,10 @@ void ConsoleYarlView::handleEvents() {
     else if (DropEvent* drop = dynamic_cast<DropEvent*>(event.get())) {
       if (drop->dropper.hp() > 0) {
         if (&drop->dropper == player) {
-          addStatusMessage("You dropped your " + drop->item.desc() + '.');
+          addStatusMessage({"You dropped your ", drop->item.desc(), "."});
         } else if (player->los(drop->dropper)) {
-          addStatusMessage("The " + drop->dropper.desc() + " dropped " +
-                           drop->item.prefix() + ' ' + drop->item.desc() + '.');
+          addStatusMessage({"The ", drop->dropper.desc(), " dropped ",
+                            drop->item.prefix(), drop->item.desc(), "."});
         }
       }
     }
@@ -445,6 +679,8 @@ void ConsoleYarlView::handleEvents() {
  * \brief Renders the main screen.
  */
 void ConsoleYarlView::draw() {
+  resizeBuffers();
+
   Player* player = _world.player();
 
   int offX = width() / 2 - player->x();
@@ -471,12 +707,7 @@ void ConsoleYarlView::draw() {
     }
   }
 
-  // render entities
-  auto ents =
-      _world.entities(player->x() - width() / 2, player->y() - height() / 2,
-                      player->x() + width() / 2, player->y() + height() / 2);
-
-  for (Entity* e : ents) {
+  auto render = [&](Entity* e) {
     if (player->los(*e)) {
       e->setSeen();
       e->setLastKnownX();
@@ -487,36 +718,73 @@ void ConsoleYarlView::draw() {
       moveAddChar(e->lastKnownX() + offX, e->lastKnownY() + offY,
                   e->t().repr());
     }
+  };
+
+  // render items on the ground below all other entities, the last item of a
+  // pile on top
+  _world.forEachPile(
+      player->x() - width() / 2, player->y() - height() / 2,
+      player->x() + width() / 2, player->y() + height() / 2,
+      [&](int x, int y, vector<GroundItem>& pile) {
+        if (player->los(x, y)) {
+          for (GroundItem& i : pile) {
+            i.seen = true;
+          }
+
+          moveAddChar(x + offX, y + offY, pile.back().tile().repr(),
+                      pile.back().tile().color());
+        } else {
+          auto i = find_if(pile.crbegin(), pile.crend(),
+                           [](GroundItem const& i) { return i.seen; });
+
+          if (i != pile.crend()) {
+            moveAddChar(x + offX, y + offY, i->tile().repr());
+          }
+        }
+      });
+
+  // render entities
+  auto ents =
+      _world.entities(player->x() - width() / 2, player->y() - height() / 2,
+                      player->x() + width() / 2, player->y() + height() / 2);
+
+  for (Entity* e : ents) {
+    render(e);
   }
 
   drawCharacterInfo();
-  refreshScreen();
-
   drawStatusBar();
+
+  refreshScreen();
 }
 
 void ConsoleYarlView::drawStatusBar() {
-  while (!_statusBar.empty()) {
-    clear(0, 0, width(), 1);
-    moveAddString(0, 0, _statusBar.getLine(width()));
+  if (_statusBar.empty()) {
+    return;
+  }
 
-    refreshScreen();
-    if (!_statusBar.empty()) {
-      getChar();
-    }
+  // New messages are shown on top of the map without waiting for a key. If
+  // they don't fit, the last line ends in ".." and the rest is shown next
+  // turn. All of them can be read again in the message log. The last screen
+  // of the game shows everything left, e.g. how the player died.
+  const int rows = _running ? _statusLines : height() - 1;
+
+  for (int row = 0; row < rows && !_statusBar.empty(); row++) {
+    clear(0, row, width(), 1);
+    moveAddString(0, row, _statusBar.getLine(width(), row == rows - 1));
   }
 }
 
 void ConsoleYarlView::drawCharacterInfo() {
   Player* player = _world.player();
 
+  clear(0, height() - 1, width(), 1);
+
   // character information
   // name
   moveAddString(0, height() - 1,
                 "foo");  //_variables["name"].toString().substr(0, 9));
 
-  clear(14, height() - 1, width() - 15, 1);
-
   // hp
   moveAddString(10, height() - 1, "HP: ");
 
@@ -41,14 +41,18 @@ class ConsoleYarlView : public YarlView {
                            std::vector<std::string> const& possibleAnswers,
                            size_t defAnswer);
 
-  Item* promptItem(std::string const& message, std::list<Item*>::iterator first,
-                   std::list<Item*>::iterator last, function<bool(Item*)> pred);
+  Item* promptItem(std::string const& message, Inventory const& inventory,
+                   function<bool(Item*)> pred);
 
-  void showItemList(std::string const& title, std::list<Item*> const& items,
+  void showItemList(std::string const& title, Inventory const& items,
                     std::function<std::string(Item*)> decorator);
 
   virtual boost::optional<std::pair<int, int>> promptCoordinates();
 
+  void showMessageLog();
+  void showMinimap();
+
+  using YarlView::addStatusMessage;
   void addStatusMessage(std::string const& message);
 
  protected:
@@ -71,42 +75,60 @@ class ConsoleYarlView : public YarlView {
   // turn the cursor on or off
   virtual void cursor(bool val) = 0;
 
+  /*!
+   * \brief Writes a run of characters of a single color to the screen.
+   *
+   * The run is not visible before present() is called.
+   */
+  virtual void drawRun(int x, int y, std::string const& s, Color col) = 0;
+
+  /*!
+   * \brief Shows all runs written since the last call.
+   * \param x,y	position of the cursor
+   */
+  virtual void present(int x, int y) = 0;
+
   // cursor coordinates
-  virtual int cursorX() const = 0;
-  virtual int cursorY() const = 0;
+  int cursorX() const;
+  int cursorY() const;
 
   /*!
    * \brief Adds a character to the screen.
    * \param c	character to be added
    * \param col color for the character to be written in
    */
-  virtual void addChar(char c, Color col = Color::white) = 0;
+  void addChar(char c, Color col = Color::white);
 
   /*!
    * \brief Writes a string to the screen
    * \param str	string to be written
    * \param col	color for the string to be written in
    */
-  virtual void addString(string s, Color col = Color::white) = 0;
+  void addString(string const& s, Color col = Color::white);
 
   /*!
    * \brief Moves the cursor to the specified position
    */
-  virtual void moveCursor(int x, int y) = 0;
+  void moveCursor(int x, int y);
 
   // combined functions
   void moveAddChar(int x, int y, char c, Color col = Color::white);
-  void moveAddString(int x, int y, string s, Color col = Color::white);
+  void moveAddString(int x, int y, string const& s, Color col = Color::white);
 
   void handleEvents();
 
   /*!
    * \brief Clears a part of the screen.
    */
-  virtual void clear(int x, int y, int w, int h) = 0;
+  void clear(int x, int y, int w, int h);
 
-  // show all changes made to the streambuffer
-  virtual void refreshScreen() = 0;
+  /*!
+   * \brief Shows all changes made to the screen.
+   *
+   * Only cells which differ from what is currently shown are passed on to
+   * the backend, as runs grouped by color.
+   */
+  void refreshScreen();
 
  private:
   void draw();
@@ -114,6 +136,40 @@ class ConsoleYarlView : public YarlView {
   void drawStatusBar();
   void drawCharacterInfo();
 
+  // adapts the cell buffers to the screen size
+  void resizeBuffers();
+
+  struct Cell {
+    char c;
+    Color col;
+
+    bool operator==(Cell const& rhs) const {
+      return c == rhs.c && col == rhs.col;
+    }
+
+    bool operator!=(Cell const& rhs) const { return !(*this == rhs); }
+  };
+
+  // a run of changed cells of the same color
+  struct Run {
+    int x;
+    int y;
+    std::string s;
+    Color col;
+  };
+
+  // the screen as drawn since the last refresh
+  std::vector<Cell> _cells;
+  // the screen as currently shown by the backend
+  std::vector<Cell> _shown;
+  std::vector<Run> _runs;
+
+  int _bufWidth{0};
+  int _bufHeight{0};
+
+  int _cursX{0};
+  int _cursY{0};
+
   bool _running;
 
   YarlController& _controller;
@@ -122,6 +178,9 @@ class ConsoleYarlView : public YarlView {
   std::map<char, Command> _bindings;
 
   StatusBar _statusBar;
+  // the status bar grows up to this many lines before new messages are held
+  // back for the next turn
+  static const int _statusLines;
 };
 
 #endif
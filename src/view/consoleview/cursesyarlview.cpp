@@ -17,6 +17,7 @@
  */
 
 #include "cursesyarlview.h"
+#include "yarlviewfactory.h"
 #include <curses.h>
 
 short CursesYarlView::cp(Color col) {
@@ -63,6 +64,8 @@ CursesYarlView::CursesYarlView(YarlController& controller, World& world)
       init_pair(i, i, COLOR_BLACK);
     }
   }
+
+  attrset(COLOR_PAIR(cp(_color)));
 }
 
 CursesYarlView::~CursesYarlView() { endwin(); }
@@ -73,22 +76,21 @@ int CursesYarlView::height() const { return getmaxy(stdscr); }
 
 void CursesYarlView::cursor(bool val) { curs_set(val); }
 
-int CursesYarlView::cursorX() const { return getcurx(stdscr); }
-
-int CursesYarlView::cursorY() const { return getcury(stdscr); }
+void CursesYarlView::drawRun(int x, int y, std::string const& s,
+                             Color col) {
+  if (col != _color) {
+    attrset(COLOR_PAIR(cp(col)));
+    _color = col;
+  }
 
-void CursesYarlView::addChar(char c, Color col) {
-  attrset(COLOR_PAIR(cp(col)));
-  addch(c);
+  mvaddstr(y, x, s.c_str());
 }
 
-void CursesYarlView::addString(string s, Color col) {
-  attrset(COLOR_PAIR(cp(col)));
-  addstr(s.c_str());
+void CursesYarlView::present(int x, int y) {
+  move(y, x);
+  refresh();
 }
 
-void CursesYarlView::moveCursor(int x, int y) { move(y, x); }
-
 char CursesYarlView::getChar() {
   if (_lastInput != 0) {
     char ret = _lastInput;
@@ -114,14 +116,7 @@ void CursesYarlView::waitForInput() {
   }
 }
 
-void CursesYarlView::clear(int x, int y, int w, int h) {
-  for (int i = 0; i < w; i++) {
-    move(y, x + i);
-
-    for (int j = 0; j < h; j++) {
-      addch(' ');
-    }
-  }
+std::unique_ptr<YarlView> makeCursesView(YarlController& controller,
+                                         World& world, ViewOptions const&) {
+  return std::make_unique<CursesYarlView>(controller, world);
 }
-
-void CursesYarlView::refreshScreen() { refresh(); }
@@ -38,27 +38,16 @@ class CursesYarlView : public ConsoleYarlView {
   // turn the cursor on or off
   void cursor(bool val);
 
-  // cursor coordinates
-  int cursorX() const;
-  int cursorY() const;
-
-  // replace the character at the current cursor location
-  void addChar(char c, Color col = Color::white);
-  // write a string of characters
-  void addString(string s, Color col = Color::white);
-
-  // move the cursor to the given coordinates
-  void moveCursor(int x, int y);
-
-  void clear(int x, int y, int w, int h);
-
-  // show all changes made to the streambuffer
-  void refreshScreen();
+  void drawRun(int x, int y, std::string const& s, Color col);
+  void present(int x, int y);
 
  private:
   short cp(Color col);
 
   char _lastInput{0};
+
+  // the color last set, to avoid redundant attribute changes
+  Color _color{Color::white};
 };
 
 #endif
@@ -0,0 +1,94 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "nullyarlview.h"
+#include "yarlviewfactory.h"
+#include <iostream>
+#include <iterator>
+
+const int NullYarlView::_width = 80;
+const int NullYarlView::_height = 25;
+
+NullYarlView::NullYarlView(YarlController& controller, World& world,
+                           std::string const& inputFile,
+                           std::string const& framesFile)
+    : ConsoleYarlView(controller, world),
+      _rows(_height, std::string(_width, ' ')) {
+  if (!inputFile.empty()) {
+    std::ifstream input(inputFile);
+
+    if (input.is_open()) {
+      _input.assign(std::istreambuf_iterator<char>(input),
+                    std::istreambuf_iterator<char>());
+    } else {
+      std::cerr << "Error: could not open input file " << inputFile << '\n';
+    }
+  }
+
+  if (!framesFile.empty()) {
+    _frames.open(framesFile);
+
+    if (!_frames.is_open()) {
+      std::cerr << "Error: could not open frame file " << framesFile << '\n';
+    }
+  }
+}
+
+char NullYarlView::getChar() {
+  if (_inputPos < _input.size()) {
+    return _input[_inputPos++];
+  }
+
+  // The script is over, so end the game. Until the main loop notices, every
+  // prompt is left by alternately confirming and cancelling it.
+  quit();
+
+  return (_overrun++ % 2 == 0) ? '\n' : '\x1b';
+}
+
+void NullYarlView::waitForInput() {}
+
+int NullYarlView::width() const { return _width; }
+
+int NullYarlView::height() const { return _height; }
+
+void NullYarlView::cursor(bool) {}
+
+void NullYarlView::drawRun(int x, int y, std::string const& s, Color) {
+  _rows[y].replace(x, s.size(), s);
+}
+
+void NullYarlView::present(int x, int y) {
+  if (!_frames.is_open()) {
+    return;
+  }
+
+  _frames << "frame " << _frameNo++ << " cursor " << x << ' ' << y << '\n';
+
+  for (std::string const& row : _rows) {
+    _frames.write(row.data(), row.find_last_not_of(' ') + 1);
+    _frames << '\n';
+  }
+}
+
+std::unique_ptr<YarlView> makeNullView(YarlController& controller, World& world,
+                                       ViewOptions const& options) {
+  return std::make_unique<NullYarlView>(controller, world, options.inputFile,
+                                        options.framesFile);
+}
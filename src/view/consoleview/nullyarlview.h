@@ -0,0 +1,74 @@
+/*
+ * YARL - Yet another Roguelike
+ * Copyright (C) 2015-2016  Marko van Treeck <markovantreeck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NULLYARLVIEW_H
+#define NULLYARLVIEW_H
+
+#include "consoleyarlview.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief A view without any display.
+ *
+ * The screen is only kept in memory, and the input is read from a script. This
+ * allows whole game sessions to be run without a terminal, e.g. for automated
+ * tests or benchmarks.
+ */
+class NullYarlView : public ConsoleYarlView {
+ public:
+  /*!
+   * \param inputFile	file containing the keys to be entered, or an empty
+   *			string for no input at all
+   * \param framesFile	file every presented frame is written to, or an
+   *			empty string to not record any frames
+   */
+  NullYarlView(YarlController& controller, World& world,
+               std::string const& inputFile, std::string const& framesFile);
+
+ protected:
+  char getChar();
+  void waitForInput();
+
+  int width() const;
+  int height() const;
+
+  void cursor(bool val);
+
+  void drawRun(int x, int y, std::string const& s, Color col);
+  void present(int x, int y);
+
+ private:
+  static const int _width;
+  static const int _height;
+
+  std::string _input;
+  size_t _inputPos{0};
+
+  // number of reads after the input has run out
+  size_t _overrun{0};
+
+  std::vector<std::string> _rows;
+
+  std::ofstream _frames;
+  size_t _frameNo{0};
+};
+
+#endif
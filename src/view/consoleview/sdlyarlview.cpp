@@ -17,6 +17,7 @@
  */
 
 #include "sdlyarlview.h"
+#include "yarlviewfactory.h"
 #include "yarlcontroller.h"
 #include "player.h"
 #include "command.h"
@@ -26,42 +27,41 @@
 
 const int SDLYarlView::_defaultWidth = 80;
 const int SDLYarlView::_defaultHeight = 50;
+const int SDLYarlView::_waitTimeout = 500;
 
 /*!
  * \brief Converts a color into RGBA format.
  */
-Uint32 SDLYarlView::color(Color col) {
-  SDL_Surface* screen = SDL_GetWindowSurface(_window);
-
+SDL_Color SDLYarlView::color(Color col) const {
   if (!_useColor) {
-    return SDL_MapRGB(screen->format, 0xff, 0xff, 0xff);
+    return {0xff, 0xff, 0xff, 0xff};
   }
 
   switch (col) {
     case Color::black:
-      return SDL_MapRGB(screen->format, 0x00, 0x00, 0x00);
+      return {0x00, 0x00, 0x00, 0xff};
 
     case Color::red:
-      return SDL_MapRGB(screen->format, 0xff, 0x00, 0x00);
+      return {0xff, 0x00, 0x00, 0xff};
 
     case Color::green:
-      return SDL_MapRGB(screen->format, 0x00, 0xff, 0x00);
+      return {0x00, 0xff, 0x00, 0xff};
 
     case Color::yellow:
-      return SDL_MapRGB(screen->format, 0xff, 0xff, 0x00);
+      return {0xff, 0xff, 0x00, 0xff};
 
     case Color::blue:
-      return SDL_MapRGB(screen->format, 0x00, 0x00, 0xff);
+      return {0x00, 0x00, 0xff, 0xff};
 
     case Color::magenta:
-      return SDL_MapRGB(screen->format, 0xff, 0xff, 0xff);
+      return {0xff, 0x00, 0xff, 0xff};
 
     case Color::cyan:
-      return SDL_MapRGB(screen->format, 0x00, 0xff, 0xff);
+      return {0x00, 0xff, 0xff, 0xff};
 
     default:
     case Color::white:
-      return SDL_MapRGB(screen->format, 0xff, 0xff, 0xff);
+      return {0xff, 0xff, 0xff, 0xff};
   }
 }
 
@@ -73,14 +73,14 @@ SDLYarlView::SDLYarlView(YarlController& controller, World& world)
 
   if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) < 0) {
     cerr << "Error while initializing SDL: " << SDL_GetError() << endl;
-    return;  // TODO
+    return;
   }
 
   SDL_Surface* tmpCharset = SDL_LoadBMP(charset);
 
   if (tmpCharset == nullptr) {
     cerr << "Error while trying to open char set: " << SDL_GetError() << endl;
-    return;  // TODO
+    return;
   }
 
   _charWidth = tmpCharset->w / 16;
@@ -93,23 +93,68 @@ SDLYarlView::SDLYarlView(YarlController& controller, World& world)
 
   if (_window == nullptr) {
     cerr << "Error while opening window: " << SDL_GetError() << endl;
-    return;  // TODO
+    SDL_FreeSurface(tmpCharset);
+    return;
+  }
+
+  // use whatever renderer is available; on machines without a GPU (or with
+  // the dummy video driver) this is the software renderer
+  _renderer = SDL_CreateRenderer(_window, -1, 0);
+
+  if (_renderer == nullptr) {
+    _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_SOFTWARE);
   }
 
-  SDL_Surface* screen = SDL_GetWindowSurface(_window);
+  if (_renderer == nullptr) {
+    cerr << "Error while creating renderer: " << SDL_GetError() << endl;
+    SDL_FreeSurface(tmpCharset);
+    return;
+  }
 
-  // optimise charset format
-  _charset = SDL_ConvertSurface(tmpCharset, screen->format, 0);
+  // The char set contains white glyphs on a black background. Making the
+  // background transparent lets us tint the glyphs in any color when they
+  // are copied to the screen, so the atlas has to be uploaded only once.
+  SDL_SetColorKey(tmpCharset, SDL_TRUE,
+                  SDL_MapRGB(tmpCharset->format, 0x00, 0x00, 0x00));
+  _charset = SDL_CreateTextureFromSurface(_renderer, tmpCharset);
   SDL_FreeSurface(tmpCharset);
+
+  if (_charset == nullptr) {
+    cerr << "Error while uploading char set: " << SDL_GetError() << endl;
+    return;
+  }
+
+  SDL_SetTextureBlendMode(_charset, SDL_BLENDMODE_BLEND);
+
+  SDL_StartTextInput();
 }
 
 SDLYarlView::~SDLYarlView() {
-  SDL_DestroyWindow(_window);
-  SDL_FreeSurface(_charset);
+  if (good()) {
+    SDL_StopTextInput();
+  }
+
+  // any of these may be missing if the constructor failed halfway
+  if (_charset != nullptr) {
+    SDL_DestroyTexture(_charset);
+  }
+
+  if (_renderer != nullptr) {
+    SDL_DestroyRenderer(_renderer);
+  }
+
+  if (_window != nullptr) {
+    SDL_DestroyWindow(_window);
+  }
 
   SDL_Quit();
 }
 
+/*!
+ * \brief Whether the window, renderer and char set were all set up.
+ */
+bool SDLYarlView::good() const { return _charset != nullptr; }
+
 char SDLYarlView::getChar() {
   while (_inputBuffer.empty()) {
     waitForInput();
@@ -127,110 +172,166 @@ int SDLYarlView::height() const { return _height; }
 
 void SDLYarlView::cursor(bool val) { _cursorOn = val; }
 
-int SDLYarlView::cursorX() const { return _cursX; }
-
-int SDLYarlView::cursorY() const { return _cursY; }
-
-void SDLYarlView::addChar(char c, Color col) {
-  _characters.at(_cursX + _width * _cursY) = c;
-  _colors.at(_cursX + _width * _cursY) = col;
-
-  _cursX++;
-
-  if (_cursX > _width) {
-    _cursX = 0;
-    _cursY++;
+void SDLYarlView::drawRun(int x, int y, std::string const& s, Color col) {
+  for (size_t i = 0; i < s.size() && x + int(i) < _width; i++) {
+    _characters[x + i + y * _width] = s[i];
+    _colors[x + i + y * _width] = col;
   }
 }
 
-void SDLYarlView::addString(string s, Color col) {
-  for (char c : s) {
-    addChar(c, col);
+void SDLYarlView::waitForInput() {
+  SDL_Event e;
+
+  // block until there is some input; the timeout only bounds how long a
+  // single wait may take
+  while (_inputBuffer.empty()) {
+    if (SDL_WaitEventTimeout(&e, _waitTimeout)) {
+      do {
+        handleEvent(e);
+      } while (SDL_PollEvent(&e));
+    }
   }
 }
 
-void SDLYarlView::moveCursor(int x, int y) {
-  if (x >= _width) {
-    _cursX = _width;
-  } else if (x < 0) {
-    _cursX = 0;
-  } else {
-    _cursX = x;
-  }
+void SDLYarlView::handleEvent(SDL_Event const& e) {
+  switch (e.type) {
+    case SDL_QUIT:
+      // end the game, and leave any prompt it is currently in
+      quit();
+      _inputBuffer.push('\n');
+      _inputBuffer.push('\x1b');
+      break;
+
+    case SDL_WINDOWEVENT:
+      if (e.window.event == SDL_WINDOWEVENT_EXPOSED ||
+          e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+        present(_cursX, _cursY);
+      }
+      break;
 
-  if (y >= _height) {
-    _cursY = _height;
-  } else if (y < 0) {
-    _cursY = 0;
-  } else {
-    _cursY = y;
-  }
-}
+    case SDL_KEYDOWN:
+      _repeat = e.key.repeat != 0;
 
-void SDLYarlView::waitForInput() {
-  SDL_Event e;
+      // printable keys arrive as text input, only handle the rest here
+      switch (e.key.keysym.sym) {
+        case SDLK_RETURN:
+        case SDLK_KP_ENTER:
+          pushKey('\n');
+          break;
 
-  while (true) {  // getChar has to be blocking
-    while (SDL_PollEvent(&e)) {
-      if (e.type == SDL_QUIT) {
-        //_controller.quit();
-      } else if (e.type == SDL_KEYDOWN) {
-        if (e.key.keysym.sym == SDLK_RETURN) {
-          _inputBuffer.push('\n');
-        } else {
-          _inputBuffer.push((char)e.key.keysym.sym);
-        }
+        case SDLK_BACKSPACE:
+          pushKey('\b');
+          break;
+
+        case SDLK_TAB:
+          pushKey('\t');
+          break;
 
-        return;
+        case SDLK_ESCAPE:
+          pushKey('\x1b');
+          break;
+
+        default:
+          break;
       }
-    }
+      break;
+
+    case SDL_TEXTINPUT:
+      for (char const* c = e.text.text; *c != '\0'; c++) {
+        // only ASCII characters can be displayed
+        if ((*c & 0x80) == 0) {
+          pushKey(*c);
+        }
+      }
+      break;
 
-    SDL_Delay(20);  // to lower CPU usage
+    default:
+      break;
   }
 }
 
-void SDLYarlView::clear(int x, int y, int w, int h) {
-  for (int i = 0; i < w; i++) {
-    for (int j = 0; j < h; j++) {
-      _characters.at(x + i + (y + j) * _width) = ' ';
-    }
+void SDLYarlView::pushKey(char c) {
+  // Repeated keys are dropped while older input is still pending, so holding
+  // a key down doesn't queue up actions faster than the game handles them.
+  if (_repeat && !_inputBuffer.empty()) {
+    return;
   }
+
+  _inputBuffer.push(c);
 }
 
-void SDLYarlView::refreshScreen() {
-  SDL_Surface* screen = SDL_GetWindowSurface(_window);
+void SDLYarlView::present(int x, int y) {
+  _cursX = x;
+  _cursY = y;
+
+  SDL_SetRenderDrawColor(_renderer, 0x00, 0x00, 0x00, 0xff);
+  SDL_RenderClear(_renderer);
+
+  if (_cursorOn) {
+    SDL_Rect pos = {_charWidth * _cursX, _charHeight * _cursY, _charWidth,
+                    _charHeight};
+
+    SDL_SetRenderDrawColor(_renderer, 0x80, 0x80, 0x80, 0xff);
+    SDL_RenderFillRect(_renderer, &pos);
+  }
+
+  int texWidth;
+  int texHeight;
+  SDL_QueryTexture(_charset, nullptr, nullptr, &texWidth, &texHeight);
+
+  // gather all glyphs of the frame into a single batch
+  _vertices.clear();
+  _indices.clear();
 
   for (int y = 0; y < _height; y++) {
     for (int x = 0; x < _width; x++) {
-      char c = _characters.at(x + y * _width);
-      Color col = _colors.at(x + y * _width);
-
-      SDL_Rect ch;
-      ch.x = _charWidth * (c & 0x0f);
-      ch.y = _charHeight * ((c & 0x70) >> 4);
-      ch.w = _charWidth;
-      ch.h = _charHeight;
-
-      SDL_Rect pos;
-      pos.x = _charWidth * x;
-      pos.y = _charHeight * y;
-      pos.w = _charWidth;
-      pos.h = _charHeight;
-
-      if (_cursorOn && _cursX == x && _cursY == y) {
-        SDL_SetColorKey(_charset, SDL_TRUE,
-                        SDL_MapRGB(screen->format, 0, 0, 0));
-        SDL_FillRect(screen, &pos,
-                     SDL_MapRGB(screen->format, 0x80, 0x80, 0x80));
-      } else {
-        SDL_SetColorKey(_charset, SDL_TRUE,
-                        SDL_MapRGB(screen->format, 0xff, 0xff, 0xff));
-        SDL_FillRect(screen, &pos, color(col));
+      char c = _characters[x + y * _width];
+
+      if (c == ' ') {
+        continue;
       }
 
-      SDL_BlitSurface(_charset, &ch, screen, &pos);
+      // the glyph under the cursor is always drawn in white
+      SDL_Color col = (_cursorOn && _cursX == x && _cursY == y)
+                          ? SDL_Color{0xff, 0xff, 0xff, 0xff}
+                          : color(_colors[x + y * _width]);
+
+      float u = float(_charWidth * (c & 0x0f)) / texWidth;
+      float v = float(_charHeight * ((c & 0x70) >> 4)) / texHeight;
+      float du = float(_charWidth) / texWidth;
+      float dv = float(_charHeight) / texHeight;
+
+      float left = float(_charWidth * x);
+      float top = float(_charHeight * y);
+      float right = left + _charWidth;
+      float bottom = top + _charHeight;
+
+      int first = _vertices.size();
+
+      _vertices.push_back({{left, top}, col, {u, v}});
+      _vertices.push_back({{right, top}, col, {u + du, v}});
+      _vertices.push_back({{right, bottom}, col, {u + du, v + dv}});
+      _vertices.push_back({{left, bottom}, col, {u, v + dv}});
+
+      for (int i : {0, 1, 2, 0, 2, 3}) {
+        _indices.push_back(first + i);
+      }
     }
   }
 
-  SDL_UpdateWindowSurface(_window);
+  SDL_RenderGeometry(_renderer, _charset, _vertices.data(), _vertices.size(),
+                     _indices.data(), _indices.size());
+
+  SDL_RenderPresent(_renderer);
+}
+
+std::unique_ptr<YarlView> makeSDLView(YarlController& controller, World& world,
+                                      ViewOptions const&) {
+  auto view = std::make_unique<SDLYarlView>(controller, world);
+
+  if (!view->good()) {
+    return nullptr;
+  }
+
+  return std::move(view);
 }
@@ -37,6 +37,9 @@ class SDLYarlView : public ConsoleYarlView {
   SDLYarlView(YarlController& controller, World& world);
   ~SDLYarlView();
 
+  // false if the view could not be set up; the error has been reported
+  bool good() const;
+
  protected:
   char getChar();
   void waitForInput();
@@ -49,29 +52,24 @@ class SDLYarlView : public ConsoleYarlView {
   // turn the cursor on or off
   void cursor(bool val);
 
-  // cursor coordinates
-  int cursorX() const;
-  int cursorY() const;
-
-  // replace the character at the current cursor location
-  void addChar(char c, Color col = Color::white);
-  // write a string of characters
-  void addString(string s, Color col = Color::white);
-
-  // move the cursor to the given coordinates
-  void moveCursor(int x, int y);
-
-  void clear(int x, int y, int w, int h);
-
-  // show all changes made to the streambuffer
-  void refreshScreen();
+  void drawRun(int x, int y, std::string const& s, Color col);
+  void present(int x, int y);
 
  private:
   int const static _defaultWidth;
   int const static _defaultHeight;
+  // longest time in ms to wait for a single event
+  int const static _waitTimeout;
+
+  SDL_Window* _window{nullptr};
+  SDL_Renderer* _renderer{nullptr};
 
-  SDL_Window* _window;
-  SDL_Surface* _charset;
+  // glyph atlas; white glyphs on a transparent background
+  SDL_Texture* _charset{nullptr};
+
+  // geometry of the glyphs of a frame, kept to avoid reallocations
+  vector<SDL_Vertex> _vertices;
+  vector<int> _indices;
 
   vector<char> _characters;
   vector<Color> _colors;
@@ -83,6 +81,8 @@ class SDLYarlView : public ConsoleYarlView {
   bool _cursorOn;
 
   std::queue<char> _inputBuffer;
+  // whether the last key pressed is being repeated
+  bool _repeat{false};
 
   // screen dimensions (in characters)
   int _width{_defaultWidth};
@@ -94,7 +94,10 @@ class SDLYarlView : public ConsoleYarlView {
 
   bool _useColor;
 
-  Uint32 color(Color col);
+  SDL_Color color(Color col) const;
+
+  void handleEvent(SDL_Event const& e);
+  void pushKey(char c);
 };
 
 #endif
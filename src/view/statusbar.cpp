@@ -16,36 +16,138 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "statusbar.h"
 
-bool StatusBar::empty() { return _messages.empty(); }
+const string StatusBar::_more = "..";
+
+StatusBar::StatusBar(size_t capacity) : _log(capacity) {}
+
+StatusBar::Entry& StatusBar::entry(size_t age) {
+  return _log[(_newest + _log.size() - age) % _log.size()];
+}
+
+const StatusBar::Entry& StatusBar::entry(size_t age) const {
+  return _log[(_newest + _log.size() - age) % _log.size()];
+}
+
+// splits the message at spaces so no line is longer than width. The wrapped
+// lines are cached with the entry until the width or the message change.
+const vector<string>& StatusBar::wrapped(const Entry& e, size_t width) const {
+  if (!e.lines.empty() && e.wrapWidth == width) {
+    return e.lines;
+  }
+
+  string text = e.text;
+
+  if (e.count > 1) {
+    text += " x" + to_string(e.count);
+  }
+
+  e.lines.clear();
+  e.wrapWidth = width;
+
+  while (text.length() > width && width > 0) {
+    size_t pos = text.rfind(' ', width);
+
+    if (pos == string::npos || pos == 0) {  // word too long, break it
+      pos = width;
+    }
+
+    e.lines.push_back(text.substr(0, pos));
+    text.erase(0, text[pos] == ' ' ? pos + 1 : pos);
+  }
 
-void StatusBar::addMessage(std::string message) {
-  _messages.push_back(message);
+  e.lines.push_back(text);
+
+  return e.lines;
 }
 
-string StatusBar::getLine(size_t maxLen) {
+bool StatusBar::empty() { return _unread == 0; }
+
+void StatusBar::addMessage(string const& message) {
+  if (_size > 0 && entry(0).text == message) {
+    // coalesce repeated messages
+    Entry& e = entry(0);
+    e.count++;
+    e.lines.clear();
+
+    if (_unread <= 1) {  // show it again
+      _unread = 1;
+      _shownLines = 0;
+    }
+
+    return;
+  }
+
+  _newest = (_newest + 1) % _log.size();
+
+  Entry& e = entry(0);
+  e.text = message;
+  e.count = 1;
+  e.lines.clear();
+
+  if (_size < _log.size()) {
+    _size++;
+  }
+
+  if (_unread < _size) {
+    _unread++;
+  } else {  // the oldest unread message was overwritten
+    _shownLines = 0;
+  }
+}
+
+string StatusBar::getLine(size_t maxLen, bool more) {
   string line;
-  string more = ".. ";
 
-  for (;;) {
-    int addChars = 2;  // preceding + leading space
+  // leave room for the leading space and the more prompt
+  const size_t width =
+      (maxLen > _more.length() + 3) ? maxLen - _more.length() - 3 : 1;
+
+  while (_unread > 0) {
+    const vector<string>& msg = wrapped(entry(_unread - 1), width);
+
+    if (msg.size() > 1) {  // long messages get lines of their own
+      if (line.empty()) {
+        line.push_back(' ');
+        line.append(msg[_shownLines++]);
 
-    if (_messages.size() > 1) {
-      addChars += more.length();
+        if (_shownLines == msg.size()) {
+          _shownLines = 0;
+          _unread--;
+        }
+      }
+
+      break;
     }
 
-    if (_messages.empty()) {
-      line.push_back(' ');
-      return line;
-    } else if (line.length() + _messages.front().length() + addChars < maxLen) {
-      line.push_back(' ');
-      line.append(_messages.front());
-      _messages.pop_front();
+    size_t addChars = 2;  // preceding + leading space
+
+    if (_unread > 1) {
+      addChars += _more.length() + 1;
     }
-    //		else if (line.empty())	// TODO
-    else {
-      return line.append(more);
+
+    if (!line.empty() && line.length() + msg[0].length() + addChars >= maxLen) {
+      break;
     }
+
+    line.push_back(' ');
+    line.append(msg[0]);
+    _unread--;
+  }
+
+  if (more && _unread > 0) {
+    line.push_back(' ');
+    line.append(_more);
   }
+
+  line.push_back(' ');
+  return line;
+}
+
+size_t StatusBar::size() const { return _size; }
+
+const vector<string>& StatusBar::lines(size_t age, size_t width) const {
+  return wrapped(entry(age), width);
 }
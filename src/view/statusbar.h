@@ -16,24 +16,59 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef STATUSBAR_H
 #define STATUSBAR_H
 
 #include <string>
-#include <list>
+#include <vector>
 
 using namespace std;
 
+// A bounded log of status messages. Messages are appended in O(1); once the
+// log is full the oldest messages are overwritten.
 class StatusBar {
  private:
-  list<string> _messages;
+  struct Entry {
+    string text;
+    int count;  // how often the message was repeated in a row
+
+    // text wrapped to wrapWidth; empty if it has to be wrapped again
+    mutable vector<string> lines;
+    mutable size_t wrapWidth;
+  };
+
+  static const string _more;
+
+  vector<Entry> _log;  // ring buffer
+  size_t _newest{0};   // index of the newest entry
+  size_t _size{0};     // number of entries in use
+
+  size_t _unread{0};      // number of newest entries not yet shown
+  size_t _shownLines{0};  // lines of the oldest unread entry already shown
+
+  Entry& entry(size_t age);
+  const Entry& entry(size_t age) const;
+  const vector<string>& wrapped(const Entry& e, size_t width) const;
 
  public:
+  StatusBar(size_t capacity = 256);
+
+  // true if there are no unread messages
   bool empty();
 
-  void addMessage(string message);
+  void addMessage(string const& message);
+
+  // returns the next line of unread messages to show in the status bar. With
+  // more set, it ends in ".." if there are unread messages left.
+  string getLine(size_t maxLen, bool more = true);
+
+  // number of messages in the log
+  size_t size() const;
 
-  string getLine(size_t maxLen);
+  // returns the message of the given age (0 being the newest) wrapped to
+  // lines no longer than width
+  const vector<string>& lines(size_t age, size_t width) const;
 };
 
 #endif
@@ -19,3 +19,14 @@
 #include "yarlview.h"
 
 YarlView::~YarlView() {}
+
+void YarlView::addStatusMessage(
+    std::initializer_list<boost::string_view> parts) {
+  _messageBuffer.clear();
+
+  for (boost::string_view part : parts) {
+    _messageBuffer.append(part.data(), part.size());
+  }
+
+  addStatusMessage(_messageBuffer);
+}
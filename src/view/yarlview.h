@@ -24,8 +24,11 @@
 #include <functional>
 #include <vector>
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+#include <initializer_list>
 
 class Item;
+class Inventory;
 
 enum class Color { black, red, green, yellow, blue, magenta, cyan, white };
 
@@ -50,22 +53,20 @@ class YarlView {
       size_t defAnswer) = 0;
 
   /*!
-   * \brief Prompts the user to select an item from a range.
+   * \brief Prompts the user to select an item from an inventory.
    *
    * \param message	message shown to the user
    * \param pred	the predicate after which the selectable elements are
    *    obtained.
    *		The user is only shown items for which the predicate holds true.
    *
-   * The function displays the user a list containing the items in the range
-   * [first, last) for * which the predicate holds true, from which he can
-   * select one.
+   * The function lets the user select one of the items in the inventory for
+   * which the predicate holds true.
    *
    * \returns a pointer to the selected Item, or none if no item was chosen.
    */
   virtual Item* promptItem(std::string const& message,
-                           std::list<Item*>::iterator first,
-                           std::list<Item*>::iterator last,
+                           Inventory const& inventory,
                            std::function<bool(Item*)> pred) = 0;
 
   /*!
@@ -76,10 +77,27 @@ class YarlView {
   virtual boost::optional<std::pair<int, int>> promptCoordinates() = 0;
 
   virtual void showItemList(std::string const& title,
-                            std::list<Item*> const& items,
+                            Inventory const& items,
                             std::function<std::string(Item*)> decorate) = 0;
 
+  // shows the log of past status messages
+  virtual void showMessageLog() = 0;
+
+  // shows an overview of the explored parts of the world
+  virtual void showMinimap() = 0;
+
   virtual void addStatusMessage(std::string const& message) = 0;
+
+  /*!
+   * \brief Adds a status message put together from several parts.
+   *
+   * The parts are concatenated in a buffer which is reused for every message,
+   * so composing a message does not create any temporary strings.
+   */
+  void addStatusMessage(std::initializer_list<boost::string_view> parts);
+
+ private:
+  std::string _messageBuffer;
 };
 
 #endif
@@ -18,17 +18,62 @@
 
 #include "yarlviewfactory.h"
 #include "yarlconfig.h"
+#include <iostream>
 
-#if USE_SDL == ON
-#include "sdlyarlview.h"
-#else
-#include "cursesyarlview.h"
-#endif
+namespace {
+struct Backend {
+  char const* name;
+  std::unique_ptr<YarlView> (*make)(YarlController&, World&,
+                                    ViewOptions const&);
+};
 
-std::unique_ptr<YarlView> makeView(YarlController& controller, World& world) {
+// all backends compiled into this binary; the first one is the default
+Backend const backends[] = {
 #if USE_SDL == ON
-  return std::make_unique<SDLYarlView>(controller, world);
-#else
-  return std::make_unique<CursesYarlView>(controller, world);
+    {"sdl", &makeSDLView},
 #endif
+#if USE_CURSES == ON
+    {"curses", &makeCursesView},
+#endif
+    {"null", &makeNullView}};
+}
+
+std::unique_ptr<YarlView> makeView(YarlController& controller, World& world,
+                                   ViewOptions const& options) {
+  if (options.backend.empty()) {
+    // fall back to the next interactive backend if the default one can't be
+    // set up (e.g. no display); the null view has to be asked for explicitly
+    for (Backend const& backend : backends) {
+      if (std::string(backend.name) == "null") {
+        break;
+      }
+
+      if (auto view = backend.make(controller, world, options)) {
+        return view;
+      }
+
+      std::cerr << "Warning: could not start the " << backend.name
+                << " view\n";
+    }
+
+    return nullptr;
+  }
+
+  for (Backend const& backend : backends) {
+    if (options.backend == backend.name) {
+      return backend.make(controller, world, options);
+    }
+  }
+
+  return nullptr;
+}
+
+std::vector<std::string> viewBackends() {
+  std::vector<std::string> names;
+
+  for (Backend const& backend : backends) {
+    names.push_back(backend.name);
+  }
+
+  return names;
 }
@@ -23,7 +23,39 @@
 #include "yarlcontroller.h"
 #include "world.h"
 #include <memory>
+#include <string>
+#include <vector>
 
-std::unique_ptr<YarlView> makeView(YarlController& controller, World& world);
+struct ViewOptions {
+  // name of the view backend to use; the default one if empty
+  std::string backend;
+  // keys to enter in a headless run
+  std::string inputFile;
+  // file to record the frames of a headless run to
+  std::string framesFile;
+};
+
+/*!
+ * \brief Creates the view backend selected in the options.
+ * If no backend is given, the default one is tried first, followed by the
+ * other interactive ones.
+ * \return the view, or nullptr if there is no backend of the given name or
+ * it could not be set up.
+ */
+std::unique_ptr<YarlView> makeView(YarlController& controller, World& world,
+                                   ViewOptions const& options);
+
+// names of all available view backends, the default one first
+std::vector<std::string> viewBackends();
+
+// factories of the individual backends, defined in their libraries; they
+// report their own errors and return nullptr if the backend can't be used
+std::unique_ptr<YarlView> makeSDLView(YarlController& controller, World& world,
+                                      ViewOptions const& options);
+std::unique_ptr<YarlView> makeCursesView(YarlController& controller,
+                                         World& world,
+                                         ViewOptions const& options);
+std::unique_ptr<YarlView> makeNullView(YarlController& controller, World& world,
+                                       ViewOptions const& options);
 
 #endif
@@ -38,6 +38,13 @@
 
 using namespace std;
 
+const int YarlController::_maxRunSteps = 100;
+
+// e.g. " (3)" for a stack of three items
+static string stackSize(int count) {
+  return count > 1 ? " (" + to_string(count) + ")" : "";
+}
+
 bool YarlController::init(int argc, char* argv[]) {
   // initialize variables
   //	_variables = map<string, Variable> {
@@ -61,6 +68,17 @@ bool YarlController::init(int argc, char* argv[]) {
                                  {'b', Command::southWest},
                                  {'n', Command::southEast},
 
+                                 {'H', Command::runWest},
+                                 {'L', Command::runEast},
+                                 {'K', Command::runNorth},
+                                 {'J', Command::runSouth},
+                                 {'Y', Command::runNorthWest},
+                                 {'U', Command::runNorthEast},
+                                 {'B', Command::runSouthWest},
+                                 {'N', Command::runSouthEast},
+                                 {'_', Command::travel},
+                                 {'o', Command::explore},
+
                                  {'.', Command::wait},
 
                                  {'f', Command::twoWeaponFightingToggle},
@@ -73,6 +91,8 @@ bool YarlController::init(int argc, char* argv[]) {
                                  {'i', Command::inventory},
 
                                  {'/', Command::examine},
+                                 {'p', Command::messageLog},
+                                 {'M', Command::minimap},
 
                                  {'q', Command::quit}};
 
@@ -112,6 +132,11 @@ bool YarlController::init(int argc, char* argv[]) {
                  //_variables["name"] = name;
   }
 
+  ViewOptions viewOptions;
+  World::Pathfinder pathfinder = World::Pathfinder::aStar;
+  string autosaveFile;
+  string archetypeFile = "archetypes.txt";
+
   for (int i = 0; i < argc; i++) {
     string arg = argv[i];
 
@@ -154,6 +179,78 @@ bool YarlController::init(int argc, char* argv[]) {
         return false;
       }
     }
+
+    else if (arg == "--view") {
+      i++;
+
+      if (i < argc) {
+        viewOptions.backend = argv[i];
+      } else {
+        cerr << "Error: expected view backend!\n";
+
+        usage(cerr);
+        return false;
+      }
+    }
+
+    else if (arg == "--pathfinder") {
+      i++;
+
+      if (i < argc && string(argv[i]) == "astar") {
+        pathfinder = World::Pathfinder::aStar;
+      } else if (i < argc && string(argv[i]) == "jps") {
+        pathfinder = World::Pathfinder::jumpPoint;
+      } else {
+        cerr << "Error: expected path finder (astar or jps)!\n";
+
+        usage(cerr);
+        return false;
+      }
+    }
+
+    else if (arg == "--archetypes") {
+      i++;
+
+      if (i < argc) {
+        archetypeFile = argv[i];
+      } else {
+        cerr << "Error: expected archetype file name!\n";
+
+        usage(cerr);
+        return false;
+      }
+    }
+
+    else if (arg == "--autosave") {
+      i++;
+
+      if (i < argc) {
+        autosaveFile = argv[i];
+      } else {
+        cerr << "Error: expected autosave file name!\n";
+
+        usage(cerr);
+        return false;
+      }
+    }
+
+    else if (arg == "--headless") {
+      viewOptions.backend = "null";
+    }
+
+    else if (arg == "--input" || arg == "--frames") {
+      i++;
+
+      if (i < argc) {
+        (arg == "--input" ? viewOptions.inputFile : viewOptions.framesFile) =
+            argv[i];
+      } else {
+        cerr << "Error: expected file name after " << arg << "!\n";
+
+        usage(cerr);
+        return false;
+      }
+    }
   }
 
   // if there is a potential config file, try to load it
@@ -196,11 +293,23 @@ bool YarlController::init(int argc, char* argv[]) {
                                       {"northWest", Command::northWest},
                                       {"southEast", Command::southEast},
                                       {"southWest", Command::southWest},
+                                      {"runWest", Command::runWest},
+                                      {"runSouth", Command::runSouth},
+                                      {"runNorth", Command::runNorth},
+                                      {"runEast", Command::runEast},
+                                      {"runNorthEast", Command::runNorthEast},
+                                      {"runNorthWest", Command::runNorthWest},
+                                      {"runSouthEast", Command::runSouthEast},
+                                      {"runSouthWest", Command::runSouthWest},
+                                      {"travel", Command::travel},
+                                      {"explore", Command::explore},
                                       {"equip", Command::equip},
                                       {"pickup", Command::pickup},
                                       {"drop", Command::drop},
                                       {"inventory", Command::inventory},
                                       {"wait", Command::wait},
+                                      {"messageLog", Command::messageLog},
+                                      {"minimap", Command::minimap},
                                       {"quit", Command::quit}};
 
           string keyS;
@@ -229,10 +338,53 @@ bool YarlController::init(int argc, char* argv[]) {
     }
   }
 
+  if (!_archetypes.load(archetypeFile)) {
+    return false;
+  }
+
+  Archetype const* player = _archetypes.find("player");
+
+  if (player == nullptr || player->kind != Archetype::Kind::player) {
+    cerr << "Error: " << archetypeFile << ": expected a player archetype\n";
+    return false;
+  }
+
   // create test world
-  _world = make_unique<World>(5, 5);
+  _world = make_unique<World>(5, 5, _archetypes);
+  _world->setPathfinder(pathfinder);
+
+  if (!autosaveFile.empty()) {
+    auto autosave = make_unique<Autosave>(autosaveFile);
+
+    if (!autosave->good()) {
+      return false;
+    }
+
+    _world->setAutosave(move(autosave));
+  }
+
+  _explorer = make_unique<Explorer>(*_world);
+
+  _view = makeView(*this, *_world, viewOptions);
 
-  _view = makeView(*this, *_world);
+  if (!_view) {
+    vector<string> const backends = viewBackends();
+
+    if (viewOptions.backend.empty()) {
+      cerr << "Error: could not start any view; try --headless\n";
+    } else if (find(backends.begin(), backends.end(), viewOptions.backend) ==
+               backends.end()) {
+      cerr << "Error: unknown view backend \"" << viewOptions.backend
+           << "\"\n";
+
+      usage(cerr);
+    } else {
+      cerr << "Error: could not start the " << viewOptions.backend
+           << " view\n";
+    }
+
+    return false;
+  }
 
   // seed RNG
   srand(time(0));
@@ -249,7 +401,26 @@ void YarlController::usage(ostream& out) {
          "\t-h, --help\tthis screen.\n"
          "\t-v, --version\tversion information.\n"
          "\t-c, --config <file name>\n"
-         "\t\t\tconfiguration file to read from.\n";
+         "\t\t\tconfiguration file to read from.\n"
+         "\t--view <backend>\n"
+         "\t\t\tview backend to use, one of:";
+
+  for (string const& backend : viewBackends()) {
+    out << ' ' << backend;
+  }
+
+  out << "\n"
+         "\t--pathfinder <astar|jps>\n"
+         "\t\t\talgorithm used for finding routes (default astar).\n"
+         "\t--archetypes <file name>\n"
+         "\t\t\ttable of all kinds of characters and items.\n"
+         "\t--autosave <file name>\n"
+         "\t\t\tperiodically save the game to a file in the background.\n"
+         "\t--headless\trun without display (same as --view null).\n"
+         "\t--input <file name>\n"
+         "\t\t\tkeys to enter in a headless run.\n"
+         "\t--frames <file name>\n"
+         "\t\t\tfile to record the frames of a headless run to.\n";
 }
 
 int YarlController::exec(int argc, char* argv[]) {
@@ -277,24 +448,9 @@ void YarlController::moveCommand(Command direction) {
   }
 
   Player* player = _world->player();
-  int dx = 0;
-  int dy = 0;
-
-  if (direction == Command::west || direction == Command::northWest ||
-      direction == Command::southWest) {
-    dx = -1;
-  } else if (direction == Command::east || direction == Command::northEast ||
-             direction == Command::southEast) {
-    dx = 1;
-  }
-
-  if (direction == Command::north || direction == Command::northWest ||
-      direction == Command::northEast) {
-    dy = -1;
-  } else if (direction == Command::south || direction == Command::southWest ||
-             direction == Command::southEast) {
-    dy = 1;
-  }
+  int dx;
+  int dy;
+  offset(direction, dx, dy);
 
   if (!player->move(dx, dy)) {  // an entity is blocking
     auto ents = _world->entities(player->x() + dx, player->y() + dy);
@@ -312,10 +468,16 @@ void YarlController::moveCommand(Command direction) {
     if (ents.size() > 1) {
       for (Entity* e : boost::adaptors::reverse(ents)) {
         if (e != player) {
-          _view->addStatusMessage("You see a " + e->desc() + " here.");
+          _view->addStatusMessage({"You see a ", e->desc(), " here."});
         }
       }
     }
+
+    for (GroundItem const& i :
+         boost::adaptors::reverse(_world->items(player->x(), player->y()))) {
+      _view->addStatusMessage(
+          {"You see a ", i.tile().desc(), stackSize(i.count), " here."});
+    }
   }
 }
 
@@ -325,14 +487,17 @@ void YarlController::showInventory() {
                       [player](Item* i) { return player->itemStatus(i); });
 }
 
+void YarlController::showMessageLog() { _view->showMessageLog(); }
+
+void YarlController::showMinimap() { _view->showMinimap(); }
+
 void YarlController::equip() {
   auto player = _world->player();
 
   // prompt the player for equippable items
   if (boost::optional<Item*> item = _view->promptItem(
-          "Select an item to equip:", player->inventory().begin(),
-          player->inventory().end(), [](Item* i) {
-            return dynamic_cast<Armor*>(i) || dynamic_cast<Weapon*>(i);
+          "Select an item to equip:", player->inventory(), [](Item* i) {
+            return i->category() != Inventory::Category::other;
           })) {
     Armor* armor = dynamic_cast<Armor*>(*item);
     Weapon* weapon = dynamic_cast<Weapon*>(*item);
@@ -371,7 +536,7 @@ void YarlController::equip() {
         string items;
 
         if (player->mainHand() && player->mainHand() != item) {
-          items += player->mainHand()->desc();
+          items += player->mainHand()->desc().to_string();
         }
 
         if (player->offHand() && player->offHand() != item &&
@@ -380,17 +545,17 @@ void YarlController::equip() {
             items += " and your ";
           }
 
-          items += player->offHand()->desc();
+          items += player->offHand()->desc().to_string();
         }
 
         if (!items.empty()) {
-          _view->addStatusMessage("You have to unequip your " + items +
-                                  " first.");
+          _view->addStatusMessage({"You have to unequip your ", items,
+                                   " first."});
         } else {
           player->setMainHand(*item);
           player->setOffHand(*item);
-          _view->addStatusMessage("You are now holding the " + (*item)->desc() +
-                                  " in both hands.");
+          _view->addStatusMessage({"You are now holding the ", (*item)->desc(),
+                                   " in both hands."});
         }
       }
     } else {  // item not equippable
@@ -404,8 +569,8 @@ void YarlController::equip() {
 void YarlController::unequip() {
   auto player = _world->player();
   if (boost::optional<Item*> item = _view->promptItem(
-          "What item do you want do take off?", player->inventory().begin(),
-          player->inventory().end(), [player](Item* i) {
+          "What item do you want do take off?", player->inventory(),
+          [player](Item* i) {
             return player->mainHand() == i || player->offHand() == i ||
                    player->armor() == i;
           })) {
@@ -425,28 +590,21 @@ void YarlController::unequip() {
 
 void YarlController::drop() {
   auto player = _world->player();
-  auto inventory = player->inventory();
   if (Item* item =
-          _view->promptItem("What item do you want to drop?", inventory.begin(),
-                            inventory.end(), [](Item*) { return true; })) {
+          _view->promptItem("What item do you want to drop?",
+                            player->inventory(), [](Item*) { return true; })) {
     if (player->armor() == item) {
       // you have to take off armor before you can drop armor
       _view->addStatusMessage("You cannot drop worn armor.");
     } else {
-      // unequip item if it's being held
-      if (player->mainHand() == item) {
-        player->setMainHand(nullptr);
-      } else if (player->offHand() == item) {
-        player->setOffHand(nullptr);
-      }
-
-      // drop item
-      _world->addEvent(std::make_unique<DropEvent>(*player, *item));
-
       Character::Load before = player->load();
 
-      (item)->setXY(player->x(), player->y());
-      player->inventory().remove(item);
+      // also unequips the item if it's being held
+      player->removeItem(item);
+      _world->putItem(item, player->x(), player->y());
+
+      // the item has been retired, but is still around for the event
+      _world->addEvent(std::make_unique<DropEvent>(*player, *item));
 
       Character::Load after = player->load();
 
@@ -469,6 +627,145 @@ void YarlController::drop() {
   }
 }
 
+/*!
+ * \brief Walks into a direction until something interesting happens.
+ */
+void YarlController::run(Command direction) {
+  // the run commands are in the same order as the movement commands
+  Command const step =
+      Command(int(direction) - int(Command::RUN_BEGIN) +
+              int(Command::MOVEMENT_BEGIN));
+
+  walk([step]() { return step; }, _maxRunSteps);
+}
+
+/*!
+ * \brief Walks to a location chosen by the user.
+ */
+void YarlController::travel() {
+  Player const* player = _world->player();
+
+  if (auto pos = _view->promptCoordinates()) {
+    int x, y;
+    std::tie(x, y) = *pos;
+
+    if (!_world->explored(x, y)) {
+      _view->addStatusMessage("You don't know the way there.");
+      return;
+    }
+
+    auto const path = _world->route(player->x(), player->y(), x, y);
+
+    if (path.front() == Command::none) {
+      _view->addStatusMessage("You can't get there.");
+      return;
+    }
+
+    auto i = path.begin();
+    walk([&i]() { return *i++; }, path.size());
+  } else {
+    _view->addStatusMessage("Never mind");
+  }
+}
+
+/*!
+ * \brief Walks towards the nearest unexplored area.
+ */
+void YarlController::explore() {
+  Player const* player = _world->player();
+
+  Command step = _explorer->next(player->x(), player->y());
+
+  if (step == Command::none) {
+    if (_explorer->blocked()) {
+      _view->addStatusMessage("Something is in your way.");
+    } else {
+      _view->addStatusMessage("There is nothing left to explore nearby.");
+    }
+
+    return;
+  }
+
+  walk(
+      [&]() {
+        // the first step is already known
+        if (step != Command::none) {
+          Command const first = step;
+          step = Command::none;
+          return first;
+        }
+
+        return _explorer->next(player->x(), player->y());
+      },
+      _maxRunSteps);
+}
+
+/*!
+ * \brief Moves the player along a path.
+ *
+ * The steps are taken from next() until it returns Command::none. The world
+ * keeps being simulated after every step, but nothing is rendered until the
+ * walk is over. It stops early when the path is blocked, the player gets
+ * hurt, a character not seen before comes into view or there is something on
+ * the ground.
+ */
+void YarlController::walk(function<Command()> next, int maxSteps) {
+  Player* player = _world->player();
+
+  int const hp = player->hp();
+  set<Entity*> const seen = seenCharacters();
+
+  for (int i = 0; i < maxSteps; i++) {
+    Command const direction = next();
+
+    if (direction == Command::none) {
+      break;
+    }
+
+    int dx;
+    int dy;
+    offset(direction, dx, dy);
+
+    if (!_world->passable(player->x() + dx, player->y() + dy)) {
+      break;
+    }
+
+    moveCommand(direction);
+    player->explore();
+    _world->think();
+
+    if (player->hp() < hp) {
+      break;
+    }
+
+    // the player is always standing on its own position
+    if (_world->entities(player->x(), player->y()).size() > 1 ||
+        !_world->items(player->x(), player->y()).empty()) {
+      break;
+    }
+
+    set<Entity*> const now = seenCharacters();
+
+    if (!includes(seen.begin(), seen.end(), now.begin(), now.end())) {
+      break;
+    }
+  }
+}
+
+// returns all other living characters the player currently sees
+set<Entity*> YarlController::seenCharacters() {
+  Player* player = _world->player();
+  set<Entity*> chars;
+
+  for (Entity* e : player->seenEntities()) {
+    if (e != player && e->hp() > 0 && dynamic_cast<Character*>(e)) {
+      chars.insert(e);
+    }
+  }
+
+  return chars;
+}
+
 void YarlController::examine() {
   // user entered coordinates
   if (auto pos = _view->promptCoordinates()) {
@@ -482,15 +779,23 @@ void YarlController::examine() {
       auto e =
           std::find_if(ents.cbegin(), ents.cend(), std::mem_fn(&Entity::seen));
 
+      // items are drawn below the other entities, the last one on top
+      auto const& items = _world->items(x, y);
+      auto i = std::find_if(items.crbegin(), items.crend(),
+                            [](GroundItem const& i) { return i.seen; });
+
       Tile const* t = nullptr;
       if (e != ents.cend()) {
         t = &(*e)->t();
+      } else if (i != items.crend()) {
+        t = &i->tile();
       } else {  // no entity found, show information on the ground
         t = _world->tile(x, y);
       }
 
-      _view->addStatusMessage(string() + t->repr() + " - " + t->prefix() +
-                              t->desc());
+      const char repr = t->repr();
+      _view->addStatusMessage({boost::string_view(&repr, 1), " - ",
+                               t->prefix(), t->desc()});
     } else {
       _view->addStatusMessage("Unknown");
     }
@@ -508,16 +813,13 @@ void YarlController::pickup() {
   Player* player = _world->player();
   Character::Load before = player->load();
 
-  // search for entities in reach of the player
-  for (Entity* e : _world->entities(player->x(), player->y())) {
-    if (dynamic_cast<Item*>(e) != nullptr) {
-      _world->removeEntity(e);
-      e->setXY(-1, -1);
-      player->inventory().push_back((Item*)e);
+  // pick up everything lying below the player
+  while (Item* i = _world->takeItem(player->x(), player->y(), 0)) {
+    _view->addStatusMessage(
+        {"You pick up the ", i->desc(), stackSize(i->count()), "."});
 
-      _view->addStatusMessage("You pick up the " + e->desc() + '.');
-      _world->letTimePass(2);
-    }
+    player->addItem(i);
+    _world->letTimePass(2);
   }
 
   // check if character load has changed; display a message if this is a case
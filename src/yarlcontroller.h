@@ -25,15 +25,23 @@
 #include "command.h"
 #include "world.h"
 #include "yarlview.h"
+#include "explorer.h"
+#include "archetypes.h"
 #include <iostream>
 #include <memory>
 #include <string>
 #include <map>
+#include <set>
+#include <vector>
+#include <functional>
 
 class Player;
 
 class YarlController {
  private:
+  // has to outlive the world, as its entities refer to the archetypes
+  Archetypes _archetypes;
+
   std::unique_ptr<World> _world;
   std::unique_ptr<YarlView> _view;
 
@@ -45,17 +53,31 @@ class YarlController {
   int cleanup();
   void usage(ostream& out = cout);
 
+  // longest distance walked by a single run command
+  static const int _maxRunSteps;
+
+  // guides the explore command
+  std::unique_ptr<Explorer> _explorer;
+
+  void walk(function<Command()> next, int maxSteps);
+  set<Entity*> seenCharacters();
+
  public:
   int exec(int argc, char* argv[]);
   void quit();
 
   void moveCommand(Command direction);
+  void run(Command direction);
+  void travel();
+  void explore();
   void equip();
   void unequip();
   void pickup();
   void drop();
   void showInventory();
   void examine();
+  void showMessageLog();
+  void showMinimap();
   void twoWeaponFightingToggle();
 };
 